@@ -0,0 +1,86 @@
+#ifndef CIE_ARRAY_CONVERSION
+#define CIE_ARRAY_CONVERSION
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "instrumentation.hpp"
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace python
+{
+
+// Numpy array of doubles in C order. Such arrays are accessed in place through the buffer
+// protocol, anything else (e.g. lists or integer arrays) is converted once by numpy.
+using DoubleArray = pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>;
+
+// Copies the values of an array in one go, meant for small arguments such as knot vectors
+inline std::vector<double> toVector( const DoubleArray& array )
+{
+    SPLINEKERNEL_TIME_SCOPE( "python/array to vector", array.size( ) );
+
+    return std::vector<double>( array.data( ), array.data( ) + array.size( ) );
+}
+
+inline std::vector<std::vector<double>> toVectors( const std::vector<DoubleArray>& arrays )
+{
+    std::vector<std::vector<double>> vectors;
+
+    for( const auto& array : arrays )
+    {
+        vectors.push_back( toVector( array ) );
+    }
+
+    return vectors;
+}
+
+// Moves the vector to the heap and returns a numpy array using its buffer. The array owns the
+// vector through a capsule, which deletes it once the array is garbage collected.
+inline pybind11::array_t<double> toNumpy( std::vector<double>&& values )
+{
+    SPLINEKERNEL_TIME_SCOPE( "python/vector to array", values.size( ) );
+
+    std::unique_ptr<std::vector<double>> owner( new std::vector<double>( std::move( values ) ) );
+
+    pybind11::capsule base( owner.get( ), []( void* pointer )
+    {
+        delete static_cast<std::vector<double>*>( pointer );
+    } );
+
+    std::vector<double>& vector = *owner.release( );
+
+    return pybind11::array_t<double>( std::vector<size_t>{ vector.size( ) }, vector.data( ), base );
+}
+
+// Returns a list with one numpy array per vector, each taking over the buffer of its vector
+template<typename Container>
+pybind11::list toNumpyList( Container&& vectors )
+{
+    pybind11::list list;
+
+    for( auto& vector : vectors )
+    {
+        list.append( toNumpy( std::move( vector ) ) );
+    }
+
+    return list;
+}
+
+// Converts control points and knot vector, e.g. returned from interpolation, without copies
+template<typename ControlPoints>
+pybind11::tuple toNumpy( std::pair<ControlPoints, std::vector<double>>&& result )
+{
+    return pybind11::make_tuple( toNumpyList( std::move( result.first ) ),
+                                 toNumpy( std::move( result.second ) ) );
+}
+
+} // namespace python
+} // namespace splinekernel
+} // namespace cie
+
+#endif // CIE_ARRAY_CONVERSION
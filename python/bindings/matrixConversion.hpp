@@ -1,6 +1,11 @@
 #ifndef CIE_MATRIX_CONVERSION
 #define CIE_MATRIX_CONVERSION
 
+#include <algorithm>
+#include <memory>
+
+#include "instrumentation.hpp"
+
 namespace pybind11
 {
 namespace detail
@@ -28,16 +33,16 @@ public:
                 size_t size1 = numpyArray.shape( )[0];
                 size_t size2 = numpyArray.shape( )[1];
 
+                SPLINEKERNEL_TIME_SCOPE( "python/array to Matrix", size1 * size2 );
+
                 // value is a member defined by the PYBIND11_TYPE_CASTER macro
                 value = cie::linalg::Matrix( size1, size2, 0.0 );
 
-                // Copy matrix
-                for( size_t i = 0; i < size1; i++ )
+                // Copy matrix in one go, both are stored contiguously in row major order. Since
+                // linalg::Matrix owns its storage this is the only copy made when passing a matrix.
+                if( size1 * size2 > 0 )
                 {
-                    for( size_t j = 0; j < size2; j++ )
-                    {
-                        value( i, j ) = numpyArray.at( i, j );
-                    }
+                    std::copy( numpyArray.data( ), numpyArray.data( ) + size1 * size2, &value( 0, 0 ) );
                 }
 
                 return true; // success
@@ -55,6 +60,27 @@ public:
         return pybind11::array( std::vector<size_t>{ src.size1( ), src.size2( ) },
                                 &const_cast<cie::linalg::Matrix&>( src )( 0, 0 ) ).release( );
     }
+
+    // Conversion from a temporary linalg::Matrix, e.g. returned by value. Instead of copying the
+    // values, the matrix is moved to the heap and owned by the numpy array through a capsule.
+    static pybind11::handle cast( cie::linalg::Matrix&& src,
+                                  pybind11::return_value_policy policy,
+                                  pybind11::handle parent )
+    {
+        std::unique_ptr<cie::linalg::Matrix> owner( new cie::linalg::Matrix( std::move( src ) ) );
+
+        pybind11::capsule base( owner.get( ), []( void* pointer )
+        {
+            delete static_cast<cie::linalg::Matrix*>( pointer );
+        } );
+
+        cie::linalg::Matrix& matrix = *owner.release( );
+
+        double* data = matrix.size1( ) * matrix.size2( ) > 0 ? &matrix( 0, 0 ) : nullptr;
+
+        return pybind11::array_t<double>( std::vector<size_t>{ matrix.size1( ), matrix.size2( ) },
+                                          data, base ).release( );
+    }
 };
 
 } // detail
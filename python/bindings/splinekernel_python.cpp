@@ -2,22 +2,624 @@
 #include "pybind11/stl.h"
 #include "pybind11/numpy.h"
 
+#include <chrono>
+#include <exception>
+#include <future>
+
 #include "basisfunctions.hpp"
 #include "curve.hpp"
 #include "surface.hpp"
 #include "interpolation.hpp"
+#include "evaluationplan.hpp"
+#include "incrementalinterpolation.hpp"
+#include "threadpool.hpp"
+#include "knotvector.hpp"
+#include "bsplinecurve.hpp"
+#include "bsplinesurface.hpp"
+#include "fitting.hpp"
+#include "instrumentation.hpp"
 
 // This header defines how to convert between numpy array and linalg::Matrix
 #include "matrixConversion.hpp"
 
+// Helpers for passing numpy arrays in and out without element wise copies
+#include "arrayConversion.hpp"
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace python
+{
+
+// Calls function( ) without holding the GIL, such that other Python threads can run meanwhile.
+// The function must not touch Python objects.
+template<typename Function>
+auto withoutGil( Function function ) -> decltype( function( ) )
+{
+    pybind11::gil_scoped_release release;
+
+    return function( );
+}
+
+/*! Result of a computation running on the threads of the library. Waiting in result( ) does not
+ *  hold the GIL. The result is converted to Python objects once and then returned on every call.
+ */
+template<typename T>
+class Future
+{
+public:
+    using Conversion = pybind11::object( * )( T&& );
+
+    Future( std::future<T>&& future, Conversion conversion ) :
+        m_future( std::move( future ) ), m_conversion( conversion )
+    { }
+
+    bool done( ) const
+    {
+        return !m_future.valid( ) || m_future.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready;
+    }
+
+    pybind11::object result( )
+    {
+        if( m_future.valid( ) )
+        {
+            withoutGil( [this]( ) { m_future.wait( ); } );
+
+            try
+            {
+                m_result = m_conversion( m_future.get( ) );
+            }
+            catch( ... )
+            {
+                m_exception = std::current_exception( );
+            }
+        }
+
+        if( m_exception )
+        {
+            std::rethrow_exception( m_exception );
+        }
+
+        return m_result;
+    }
+
+private:
+    std::future<T> m_future;
+    Conversion m_conversion;
+
+    pybind11::object m_result;
+    std::exception_ptr m_exception;
+};
+
+using SurfaceFuture = Future<VectorOfMatrices>;
+using InterpolationFuture = Future<ControlPointsAndKnotVector>;
+
+pybind11::object surfaceToPython( VectorOfMatrices&& surface )
+{
+    return pybind11::cast( std::move( surface ) );
+}
+
+// Moves the matrices into numpy arrays, with the normals being an empty list for non 3D surfaces
+pybind11::dict surfaceDerivativesToPython( SurfaceDerivatives&& result )
+{
+    pybind11::dict dictionary;
+
+    dictionary["values"] = pybind11::cast( std::move( result.values ) );
+    dictionary["derivativesR"] = pybind11::cast( std::move( result.derivativesR ) );
+    dictionary["derivativesS"] = pybind11::cast( std::move( result.derivativesS ) );
+    dictionary["normals"] = pybind11::cast( std::move( result.normals ) );
+
+    return dictionary;
+}
+
+// Calls the python function with copies of each block, since the buffers are reused for the next block
+CurveSink curveSink( const pybind11::function& function )
+{
+    return [&function]( size_t firstSample, size_t size, const double* t, const double* x, const double* y )
+    {
+        pybind11::gil_scoped_acquire acquire;
+
+        function( firstSample, pybind11::array_t<double>( size, t ), pybind11::array_t<double>( size, x ),
+                  pybind11::array_t<double>( size, y ) );
+    };
+}
+
+// Moves the control point matrices and the knot vectors into numpy arrays
+pybind11::tuple surfaceFitToPython( SurfaceControlPointsAndKnotVectors&& result )
+{
+    return pybind11::make_tuple( pybind11::cast( std::move( result.first ) ), toNumpyList( std::move( result.second ) ) );
+}
+
+pybind11::object interpolationToPython( ControlPointsAndKnotVector&& result )
+{
+    return toNumpy( std::move( result ) );
+}
+
+ControlPoints2D toControlPoints2D( const std::vector<DoubleArray>& interpolationPoints )
+{
+    if( interpolationPoints.size( ) != 2 )
+    {
+        throw std::runtime_error( "Expected x and y coordinates in interpolateWithBSplineCurve." );
+    }
+
+    return { toVector( interpolationPoints[0] ), toVector( interpolationPoints[1] ) };
+}
+
+using CurveEvaluator = void( * )( const double*, size_t, const std::vector<double>&, const std::vector<double>&,
+                                  const std::vector<double>&, double*, double* );
+
+// Evaluates into freshly allocated numpy arrays, reading the parametric coordinates in place
+pybind11::list evaluateCurve( CurveEvaluator evaluator,
+                              const DoubleArray& tCoordinates,
+                              const DoubleArray& xCoordinates,
+                              const DoubleArray& yCoordinates,
+                              const DoubleArray& knotVector )
+{
+    size_t numberOfSamples = static_cast<size_t>( tCoordinates.size( ) );
+
+    pybind11::array_t<double> curveX( std::vector<size_t>{ numberOfSamples } );
+    pybind11::array_t<double> curveY( std::vector<size_t>{ numberOfSamples } );
+
+    std::vector<double> x = toVector( xCoordinates );
+    std::vector<double> y = toVector( yCoordinates );
+    std::vector<double> knots = toVector( knotVector );
+
+    const double* t = tCoordinates.data( );
+    double* targetX = curveX.mutable_data( );
+    double* targetY = curveY.mutable_data( );
+
+    // The arrays stay alive through the references held by this function
+    withoutGil( [&]( ) { evaluator( t, numberOfSamples, x, y, knots, targetX, targetY ); } );
+
+    pybind11::list curve;
+
+    curve.append( curveX );
+    curve.append( curveY );
+
+    return curve;
+}
+
+// Same as above for a curve object, whose control points and knot vector need no conversion
+pybind11::list evaluateCurve( const BSplineCurve& bsplineCurve,
+                              const DoubleArray& tCoordinates )
+{
+    size_t numberOfSamples = static_cast<size_t>( tCoordinates.size( ) );
+
+    pybind11::array_t<double> curveX( std::vector<size_t>{ numberOfSamples } );
+    pybind11::array_t<double> curveY( std::vector<size_t>{ numberOfSamples } );
+
+    const double* t = tCoordinates.data( );
+    double* targetX = curveX.mutable_data( );
+    double* targetY = curveY.mutable_data( );
+
+    withoutGil( [&]( ) { bsplineCurve.evaluate( t, numberOfSamples, targetX, targetY ); } );
+
+    pybind11::list curve;
+
+    curve.append( curveX );
+    curve.append( curveY );
+
+    return curve;
+}
+
+} // namespace python
+} // namespace splinekernel
+} // namespace cie
+
 PYBIND11_MODULE( pysplinekernel, m ) 
 {
     m.doc( ) = "spline computation kernel"; // optional module docstring
 
+    pybind11::class_<cie::splinekernel::BasisFunctionDerivatives>( m, "BasisFunctionDerivatives" )
+        .def_readonly( "polynomialDegree", &cie::splinekernel::BasisFunctionDerivatives::polynomialDegree )
+        .def_readonly( "numberOfDerivatives", &cie::splinekernel::BasisFunctionDerivatives::numberOfDerivatives )
+        .def_readonly( "knotSpans", &cie::splinekernel::BasisFunctionDerivatives::knotSpans )
+        .def_property_readonly( "values", []( pybind11::object self )
+        {
+            // View on the values that keeps the owning object alive instead of a copy
+            auto& values = self.cast<cie::splinekernel::BasisFunctionDerivatives&>( ).values;
+
+            pybind11::array_t<double> view( std::vector<size_t>{ values.size( ) }, values.data( ), self );
+
+            view.attr( "setflags" )( pybind11::arg( "write" ) = false );
+
+            return view;
+        } )
+        .def( "__call__", &cie::splinekernel::BasisFunctionDerivatives::operator() );
+
+    pybind11::class_<cie::splinekernel::EvaluationPlan>( m, "EvaluationPlan" )
+        .def( pybind11::init( []( const cie::splinekernel::python::DoubleArray& tCoordinates, size_t numberOfControlPoints,
+                                  const cie::splinekernel::python::DoubleArray& knotVector, size_t numberOfDerivatives )
+        {
+            std::vector<double> t = cie::splinekernel::python::toVector( tCoordinates );
+            std::vector<double> knots = cie::splinekernel::python::toVector( knotVector );
+
+            return cie::splinekernel::python::withoutGil( [&]( )
+            {
+                return cie::splinekernel::EvaluationPlan( t, numberOfControlPoints, knots, numberOfDerivatives );
+            } );
+        } ), pybind11::arg( "tCoordinates" ), pybind11::arg( "numberOfControlPoints" ), pybind11::arg( "knotVector" ),
+             pybind11::arg( "numberOfDerivatives" ) = 0 )
+        .def( "numberOfSamples", &cie::splinekernel::EvaluationPlan::numberOfSamples )
+        .def( "numberOfControlPoints", &cie::splinekernel::EvaluationPlan::numberOfControlPoints )
+        .def( "polynomialDegree", &cie::splinekernel::EvaluationPlan::polynomialDegree )
+        .def( "numberOfDerivatives", &cie::splinekernel::EvaluationPlan::numberOfDerivatives )
+        .def( "evaluate", []( const cie::splinekernel::EvaluationPlan& plan, const cie::splinekernel::python::DoubleArray& values )
+        {
+            std::vector<double> controlPointValues = cie::splinekernel::python::toVector( values );
+
+            return cie::splinekernel::python::toNumpy( cie::splinekernel::python::withoutGil( [&]( ) { return plan.evaluate( controlPointValues ); } ) );
+        }, "Evaluates one component" )
+        .def( "evaluate", []( const cie::splinekernel::EvaluationPlan& plan, const cie::splinekernel::python::DoubleArray& x,
+                              const cie::splinekernel::python::DoubleArray& y )
+        {
+            std::vector<double> xCoordinates = cie::splinekernel::python::toVector( x );
+            std::vector<double> yCoordinates = cie::splinekernel::python::toVector( y );
+
+            return cie::splinekernel::python::toNumpyList( cie::splinekernel::python::withoutGil( [&]( ) { return plan.evaluate( xCoordinates, yCoordinates ); } ) );
+        }, "Evaluates a 2D curve" );
+
+    pybind11::class_<cie::splinekernel::KnotVector>( m, "KnotVector" )
+        .def( pybind11::init( []( size_t numberOfControlPoints, const cie::splinekernel::python::DoubleArray& knots )
+        {
+            return cie::splinekernel::KnotVector( numberOfControlPoints, cie::splinekernel::python::toVector( knots ) );
+        } ) )
+        .def( "numberOfControlPoints", &cie::splinekernel::KnotVector::numberOfControlPoints )
+        .def( "polynomialDegree", &cie::splinekernel::KnotVector::polynomialDegree )
+        .def( "knots", &cie::splinekernel::KnotVector::knots )
+        .def( "breakpoints", &cie::splinekernel::KnotVector::breakpoints, "The distinct knot values" )
+        .def( "multiplicities", &cie::splinekernel::KnotVector::multiplicities, "How often each breakpoint appears" )
+        .def( "nonzeroKnotSpans", &cie::splinekernel::KnotVector::nonzeroKnotSpans )
+        .def( "lowerBound", &cie::splinekernel::KnotVector::lowerBound )
+        .def( "upperBound", &cie::splinekernel::KnotVector::upperBound )
+        .def( "findKnotSpan", &cie::splinekernel::KnotVector::findKnotSpan );
+
+    pybind11::class_<cie::splinekernel::BSplineFit>( m, "BSplineFit" )
+        .def( pybind11::init( []( const cie::splinekernel::python::DoubleArray& parameterPositions, const cie::splinekernel::KnotVector& knotVector,
+                                  const std::vector<double>& weights )
+        {
+            std::vector<double> t = cie::splinekernel::python::toVector( parameterPositions );
+
+            return cie::splinekernel::python::withoutGil( [&]( ) { return cie::splinekernel::BSplineFit( t, knotVector, weights ); } );
+        } ), pybind11::arg( "parameterPositions" ), pybind11::arg( "knotVector" ), pybind11::arg( "weights" ) = std::vector<double>( ) )
+        .def( "numberOfPoints", &cie::splinekernel::BSplineFit::numberOfPoints )
+        .def( "numberOfControlPoints", &cie::splinekernel::BSplineFit::numberOfControlPoints )
+        .def( "knotVector", &cie::splinekernel::BSplineFit::knotVector )
+        .def( "interpolates", &cie::splinekernel::BSplineFit::interpolates )
+        .def( "fit", []( const cie::splinekernel::BSplineFit& fit, const cie::splinekernel::python::DoubleArray& values )
+        {
+            std::vector<double> v = cie::splinekernel::python::toVector( values );
+
+            return cie::splinekernel::python::toNumpy( cie::splinekernel::python::withoutGil( [&]( ) { return fit.fit( v ); } ) );
+        }, "Control points fitting the values at the parameter positions" );
+
+    pybind11::class_<cie::splinekernel::BSplineCurve>( m, "BSplineCurve" )
+        .def( pybind11::init( []( const cie::splinekernel::python::DoubleArray& x, const cie::splinekernel::python::DoubleArray& y,
+                                  const cie::splinekernel::python::DoubleArray& knotVector )
+        {
+            return cie::splinekernel::BSplineCurve( cie::splinekernel::python::toVector( x ), cie::splinekernel::python::toVector( y ),
+                                                    cie::splinekernel::python::toVector( knotVector ) );
+        } ) )
+        .def( pybind11::init( []( const cie::splinekernel::python::DoubleArray& x, const cie::splinekernel::python::DoubleArray& y,
+                                  const cie::splinekernel::KnotVector& knotVector )
+        {
+            return cie::splinekernel::BSplineCurve( cie::splinekernel::python::toVector( x ), cie::splinekernel::python::toVector( y ), knotVector );
+        } ) )
+        .def( "numberOfControlPoints", &cie::splinekernel::BSplineCurve::numberOfControlPoints )
+        .def( "polynomialDegree", &cie::splinekernel::BSplineCurve::polynomialDegree )
+        .def( "knotVector", &cie::splinekernel::BSplineCurve::knotVector )
+        .def( "xCoordinates", &cie::splinekernel::BSplineCurve::xCoordinates )
+        .def( "yCoordinates", &cie::splinekernel::BSplineCurve::yCoordinates )
+        .def( "evaluate", pybind11::overload_cast<double>( &cie::splinekernel::BSplineCurve::evaluate, pybind11::const_ ),
+              "Evaluates the curve at one parametric coordinate" )
+        .def( "evaluate", []( const cie::splinekernel::BSplineCurve& curve, const cie::splinekernel::python::DoubleArray& t )
+        {
+            return cie::splinekernel::python::evaluateCurve( curve, t );
+        }, "Evaluates the curve at multiple parametric coordinates" )
+        .def( "stream", []( const cie::splinekernel::BSplineCurve& curve, double tBegin, double tEnd, size_t numberOfSamples,
+                            const pybind11::function& sink, size_t blockSize )
+        {
+            cie::splinekernel::python::withoutGil( [&]( )
+            {
+                curve.stream( tBegin, tEnd, numberOfSamples, cie::splinekernel::python::curveSink( sink ), blockSize );
+            } );
+        }, "Evaluates equidistant samples block by block, calling sink( firstSample, t, x, y ) with numpy arrays for each block",
+           pybind11::arg( "tBegin" ), pybind11::arg( "tEnd" ), pybind11::arg( "numberOfSamples" ), pybind11::arg( "sink" ),
+           pybind11::arg( "blockSize" ) = cie::splinekernel::defaultStreamBlockSize );
+
+    pybind11::class_<cie::splinekernel::BSplineSurface>( m, "BSplineSurface" )
+        .def( pybind11::init<const std::array<std::vector<double>, 2>&, const cie::splinekernel::VectorOfMatrices&>( ) )
+        .def( pybind11::init<const std::array<cie::splinekernel::KnotVector, 2>&, const cie::splinekernel::VectorOfMatrices&>( ) )
+        .def( "numberOfComponents", &cie::splinekernel::BSplineSurface::numberOfComponents )
+        .def( "numberOfControlPoints", &cie::splinekernel::BSplineSurface::numberOfControlPoints )
+        .def( "polynomialDegrees", &cie::splinekernel::BSplineSurface::polynomialDegrees )
+        .def( "knotVectors", &cie::splinekernel::BSplineSurface::knotVectors )
+        .def( "controlPoints", &cie::splinekernel::BSplineSurface::controlPoints )
+        .def( "createPlans", []( const cie::splinekernel::BSplineSurface& surface, const cie::splinekernel::python::DoubleArray& r,
+                                 const cie::splinekernel::python::DoubleArray& s, size_t numberOfDerivatives )
+        {
+            std::vector<double> rCoordinates = cie::splinekernel::python::toVector( r );
+            std::vector<double> sCoordinates = cie::splinekernel::python::toVector( s );
+
+            return cie::splinekernel::python::withoutGil( [&]( ) { return surface.createPlans( rCoordinates, sCoordinates, numberOfDerivatives ); } );
+        }, "Evaluation plans for the tensor product of the given coordinates",
+           pybind11::arg( "r" ), pybind11::arg( "s" ), pybind11::arg( "numberOfDerivatives" ) = 0 )
+        .def( "evaluate", pybind11::overload_cast<std::array<size_t, 2>>( &cie::splinekernel::BSplineSurface::evaluate, pybind11::const_ ),
+              "Evaluates the surface on a grid of equidistant samples", pybind11::call_guard<pybind11::gil_scoped_release>( ) )
+        .def( "evaluate", pybind11::overload_cast<const std::array<cie::splinekernel::EvaluationPlan, 2>&>( &cie::splinekernel::BSplineSurface::evaluate, pybind11::const_ ),
+              "Evaluates the surface using evaluation plans", pybind11::call_guard<pybind11::gil_scoped_release>( ) )
+        .def( "evaluate", []( const cie::splinekernel::BSplineSurface& surface, const cie::splinekernel::python::DoubleArray& r,
+                              const cie::splinekernel::python::DoubleArray& s )
+        {
+            std::vector<double> rCoordinates = cie::splinekernel::python::toVector( r );
+            std::vector<double> sCoordinates = cie::splinekernel::python::toVector( s );
+
+            return cie::splinekernel::python::withoutGil( [&]( ) { return surface.evaluate( rCoordinates, sCoordinates ); } );
+        }, "Evaluates the surface on the tensor product of the given coordinates" )
+        .def( "evaluateDerivatives", []( const cie::splinekernel::BSplineSurface& surface, std::array<size_t, 2> numberOfSamplePoints )
+        {
+            return cie::splinekernel::python::surfaceDerivativesToPython( cie::splinekernel::python::withoutGil( [&]( )
+            {
+                return surface.evaluateDerivatives( numberOfSamplePoints );
+            } ) );
+        }, "Same as evaluate, but returns a dict with values, derivativesR, derivativesS and normals" )
+        .def( "evaluateDerivatives", []( const cie::splinekernel::BSplineSurface& surface, const std::array<cie::splinekernel::EvaluationPlan, 2>& plans )
+        {
+            return cie::splinekernel::python::surfaceDerivativesToPython( cie::splinekernel::python::withoutGil( [&]( )
+            {
+                return surface.evaluateDerivatives( plans );
+            } ) );
+        }, "Same as above using evaluation plans created with numberOfDerivatives = 1" )
+        .def( "evaluateDerivatives", []( const cie::splinekernel::BSplineSurface& surface, const cie::splinekernel::python::DoubleArray& r,
+                                         const cie::splinekernel::python::DoubleArray& s )
+        {
+            std::vector<double> rCoordinates = cie::splinekernel::python::toVector( r );
+            std::vector<double> sCoordinates = cie::splinekernel::python::toVector( s );
+
+            return cie::splinekernel::python::surfaceDerivativesToPython( cie::splinekernel::python::withoutGil( [&]( )
+            {
+                return surface.evaluateDerivatives( rCoordinates, sCoordinates );
+            } ) );
+        }, "Same as above on the tensor product of the given coordinates" )
+        .def( "evaluateAtPoints", []( const cie::splinekernel::BSplineSurface& surface, const cie::splinekernel::python::DoubleArray& r,
+                                      const cie::splinekernel::python::DoubleArray& s )
+        {
+            if( r.size( ) != s.size( ) )
+            {
+                throw std::runtime_error( "Inconsistent size in BSplineSurface.evaluateAtPoints." );
+            }
+
+            size_t numberOfPoints = static_cast<size_t>( r.size( ) );
+
+            std::vector<pybind11::array_t<double>> values;
+            std::vector<double*> targets;
+
+            for( size_t iComponent = 0; iComponent < surface.numberOfComponents( ); ++iComponent )
+            {
+                values.emplace_back( std::vector<size_t>{ numberOfPoints } );
+                targets.push_back( values.back( ).mutable_data( ) );
+            }
+
+            const double* rCoordinates = r.data( );
+            const double* sCoordinates = s.data( );
+
+            cie::splinekernel::python::withoutGil( [&]( ) { surface.evaluateAtPoints( rCoordinates, sCoordinates, numberOfPoints, targets ); } );
+
+            return values;
+        }, "Evaluates the surface at scattered points ( r[i], s[i] ), returns one array per component" );
+
+    pybind11::class_<cie::splinekernel::IncrementalInterpolator>( m, "IncrementalInterpolator" )
+        .def( pybind11::init<size_t, size_t, size_t>( ), pybind11::arg( "polynomialDegree" ),
+              pybind11::arg( "numberOfComponents" ), pybind11::arg( "numberOfGeometricComponents" ) = 0 )
+        .def( "polynomialDegree", &cie::splinekernel::IncrementalInterpolator::polynomialDegree )
+        .def( "numberOfComponents", &cie::splinekernel::IncrementalInterpolator::numberOfComponents )
+        .def( "numberOfPoints", &cie::splinekernel::IncrementalInterpolator::numberOfPoints )
+        .def( "append", &cie::splinekernel::IncrementalInterpolator::append, "Appends an interpolation point" )
+        .def( "interpolate", []( cie::splinekernel::IncrementalInterpolator& interpolator )
+        {
+            return cie::splinekernel::python::toNumpy( cie::splinekernel::python::withoutGil( [&]( ) { return interpolator.interpolate( ); } ) );
+        }, "Interpolates all appended points" )
+        .def( "preview", []( cie::splinekernel::IncrementalInterpolator& interpolator, const std::vector<double>& point )
+        {
+            return cie::splinekernel::python::toNumpy( cie::splinekernel::python::withoutGil( [&]( ) { return interpolator.preview( point ); } ) );
+        }, "Interpolates all appended points and a tentative last point" );
+
+    pybind11::class_<cie::splinekernel::python::SurfaceFuture>( m, "SurfaceFuture" )
+        .def( "done", &cie::splinekernel::python::SurfaceFuture::done, "True if the result is available" )
+        .def( "result", &cie::splinekernel::python::SurfaceFuture::result, "Waits for and returns the result" );
+
+    pybind11::class_<cie::splinekernel::python::InterpolationFuture>( m, "InterpolationFuture" )
+        .def( "done", &cie::splinekernel::python::InterpolationFuture::done, "True if the result is available" )
+        .def( "result", &cie::splinekernel::python::InterpolationFuture::result, "Waits for and returns the result" );
+
+    pybind11::class_<cie::splinekernel::InstrumentationRecord>( m, "InstrumentationRecord" )
+        .def_readonly( "name", &cie::splinekernel::InstrumentationRecord::name )
+        .def_readonly( "numberOfCalls", &cie::splinekernel::InstrumentationRecord::numberOfCalls )
+        .def_readonly( "numberOfSamples", &cie::splinekernel::InstrumentationRecord::numberOfSamples )
+        .def_readonly( "seconds", &cie::splinekernel::InstrumentationRecord::seconds )
+        .def( "__repr__", []( const cie::splinekernel::InstrumentationRecord& record )
+        {
+            return "<InstrumentationRecord " + record.name + ": " + std::to_string( record.numberOfCalls ) + " calls, " +
+                std::to_string( record.numberOfSamples ) + " samples, " + std::to_string( record.seconds ) + " s>";
+        } );
+
+    m.def( "setNumberOfThreads", &cie::splinekernel::setNumberOfThreads, "Sets the number of threads used for evaluation (0 uses all hardware threads)." );
+    m.def( "getNumberOfThreads", &cie::splinekernel::getNumberOfThreads, "Returns the number of threads used for evaluation." );
+    m.def( "instrumentationEnabled", &cie::splinekernel::instrumentationEnabled, "True if compiled with SPLINEKERNEL_ENABLE_INSTRUMENTATION." );
+    m.def( "instrumentationReport", &cie::splinekernel::instrumentationReport, "Returns call counts, sample counts and times recorded per function and stage." );
+    m.def( "resetInstrumentation", &cie::splinekernel::resetInstrumentation, "Sets all recorded call counts, sample counts and times to zero." );
     m.def( "evaluateBSplineBasis", &cie::splinekernel::evaluateBSplineBasis, "Evaluates single b-spline basis function." );
-    m.def( "evaluate2DCurve", &cie::splinekernel::evaluate2DCurve, "Evaluates B-Spline curve by multiplying control points and basis functions." );
-    m.def( "evaluate2DCurveDeBoor", &cie::splinekernel::evaluate2DCurveDeBoor, "Evaluates B-Spline using DeBoor" );
-    m.def( "evaluateSurface", &cie::splinekernel::evaluateSurface, "Evaluates B-Spline surface" );
-	m.def( "interpolateWithBSplineCurve", &cie::splinekernel::interpolateWithBSplineCurve, "Returns the control points for a b-spline curve with given degree that interpolates the given points");
+    m.def( "evaluateBSplineBasisDerivatives", &cie::splinekernel::evaluateBSplineBasisDerivatives, "Evaluates nonzero b-spline basis functions and derivatives at multiple coordinates.",
+           pybind11::call_guard<pybind11::gil_scoped_release>( ) );
+    m.def( "evaluate2DCurve", []( const cie::splinekernel::python::DoubleArray& t, const cie::splinekernel::python::DoubleArray& x,
+                                  const cie::splinekernel::python::DoubleArray& y, const cie::splinekernel::python::DoubleArray& knotVector )
+    {
+        return cie::splinekernel::python::evaluateCurve( &cie::splinekernel::evaluate2DCurve, t, x, y, knotVector );
+    }, "Evaluates B-Spline curve by multiplying control points and basis functions." );
+    m.def( "stream2DCurve", []( double tBegin, double tEnd, size_t numberOfSamples, const cie::splinekernel::python::DoubleArray& x,
+                                const cie::splinekernel::python::DoubleArray& y, const cie::splinekernel::python::DoubleArray& knotVector,
+                                const pybind11::function& sink, size_t blockSize )
+    {
+        std::vector<double> xCoordinates = cie::splinekernel::python::toVector( x );
+        std::vector<double> yCoordinates = cie::splinekernel::python::toVector( y );
+        std::vector<double> knots = cie::splinekernel::python::toVector( knotVector );
+
+        cie::splinekernel::python::withoutGil( [&]( )
+        {
+            cie::splinekernel::stream2DCurve( tBegin, tEnd, numberOfSamples, xCoordinates, yCoordinates, knots,
+                                              cie::splinekernel::python::curveSink( sink ), blockSize );
+        } );
+    }, "Evaluates equidistant samples of a B-Spline curve block by block, calling sink( firstSample, t, x, y ) with numpy arrays for each block",
+           pybind11::arg( "tBegin" ), pybind11::arg( "tEnd" ), pybind11::arg( "numberOfSamples" ), pybind11::arg( "x" ), pybind11::arg( "y" ),
+           pybind11::arg( "knotVector" ), pybind11::arg( "sink" ), pybind11::arg( "blockSize" ) = cie::splinekernel::defaultStreamBlockSize );
+    m.def( "evaluate2DCurveDeBoor", []( const cie::splinekernel::python::DoubleArray& t, const cie::splinekernel::python::DoubleArray& x,
+                                        const cie::splinekernel::python::DoubleArray& y, const cie::splinekernel::python::DoubleArray& knotVector )
+    {
+        return cie::splinekernel::python::evaluateCurve( &cie::splinekernel::evaluate2DCurveDeBoor, t, x, y, knotVector );
+    }, "Evaluates B-Spline using DeBoor" );
+    m.def( "evaluateSurface", pybind11::overload_cast<const std::array<std::vector<double>, 2>&,
+                                                      const cie::splinekernel::VectorOfMatrices&,
+                                                      std::array<size_t, 2>>( &cie::splinekernel::evaluateSurface ), "Evaluates B-Spline surface",
+           pybind11::call_guard<pybind11::gil_scoped_release>( ) );
+    m.def( "evaluateSurface", pybind11::overload_cast<const std::array<cie::splinekernel::EvaluationPlan, 2>&,
+                                                      const cie::splinekernel::VectorOfMatrices&>( &cie::splinekernel::evaluateSurface ), "Evaluates B-Spline surface using evaluation plans",
+           pybind11::call_guard<pybind11::gil_scoped_release>( ) );
+    m.def( "evaluateSurfaceDerivatives", []( const std::array<std::vector<double>, 2>& knotVectors, const cie::splinekernel::VectorOfMatrices& controlPoints,
+                                             std::array<size_t, 2> numberOfSamplePoints )
+    {
+        return cie::splinekernel::python::surfaceDerivativesToPython( cie::splinekernel::python::withoutGil( [&]( )
+        {
+            return cie::splinekernel::evaluateSurfaceDerivatives( knotVectors, controlPoints, numberOfSamplePoints );
+        } ) );
+    }, "Evaluates B-Spline surface with partial derivatives and for 3D surfaces unit normals, returns a dict with values, derivativesR, derivativesS and normals" );
+    m.def( "evaluateSurfaceDerivatives", []( const std::array<cie::splinekernel::EvaluationPlan, 2>& plans, const cie::splinekernel::VectorOfMatrices& controlPoints )
+    {
+        return cie::splinekernel::python::surfaceDerivativesToPython( cie::splinekernel::python::withoutGil( [&]( )
+        {
+            return cie::splinekernel::evaluateSurfaceDerivatives( plans, controlPoints );
+        } ) );
+    }, "Same as above using evaluation plans created with numberOfDerivatives = 1" );
+    m.def( "evaluateSurfaceAtPoints", []( const std::array<std::vector<double>, 2>& knotVectors, const cie::splinekernel::VectorOfMatrices& controlPoints,
+                                          const cie::splinekernel::python::DoubleArray& r, const cie::splinekernel::python::DoubleArray& s )
+    {
+        std::vector<double> rCoordinates = cie::splinekernel::python::toVector( r );
+        std::vector<double> sCoordinates = cie::splinekernel::python::toVector( s );
+
+        return cie::splinekernel::python::toNumpyList( cie::splinekernel::python::withoutGil( [&]( )
+        {
+            return cie::splinekernel::evaluateSurfaceAtPoints( knotVectors, controlPoints, rCoordinates, sCoordinates );
+        } ) );
+    }, "Evaluates B-Spline surface at scattered points ( r[i], s[i] ), returns one array per component" );
+    m.def( "evaluateSurfaceAsync", []( std::array<std::vector<double>, 2> knotVectors, cie::splinekernel::VectorOfMatrices controlPoints,
+                                       std::array<size_t, 2> numberOfSamplePoints )
+    {
+        auto future = cie::splinekernel::runAsync( [knotVectors = std::move( knotVectors ), controlPoints = std::move( controlPoints ), numberOfSamplePoints]( )
+        {
+            return cie::splinekernel::evaluateSurface( knotVectors, controlPoints, numberOfSamplePoints );
+        } );
+
+        return cie::splinekernel::python::SurfaceFuture( std::move( future ), &cie::splinekernel::python::surfaceToPython );
+    }, "Same as evaluateSurface, but runs on the threads of the library and returns a SurfaceFuture" );
+    m.def( "evaluateSurfaceAsync", []( std::array<cie::splinekernel::EvaluationPlan, 2> plans, cie::splinekernel::VectorOfMatrices controlPoints )
+    {
+        auto future = cie::splinekernel::runAsync( [plans = std::move( plans ), controlPoints = std::move( controlPoints )]( )
+        {
+            return cie::splinekernel::evaluateSurface( plans, controlPoints );
+        } );
+
+        return cie::splinekernel::python::SurfaceFuture( std::move( future ), &cie::splinekernel::python::surfaceToPython );
+    }, "Same as evaluateSurface using evaluation plans, but runs on the threads of the library and returns a SurfaceFuture" );
+    m.def( "interpolateWithBSplineCurve", []( const std::vector<cie::splinekernel::python::DoubleArray>& interpolationPoints, size_t polynomialDegree )
+    {
+        cie::splinekernel::ControlPoints2D points = cie::splinekernel::python::toControlPoints2D( interpolationPoints );
+
+        return cie::splinekernel::python::toNumpy( cie::splinekernel::python::withoutGil( [&]( )
+        {
+            return cie::splinekernel::interpolateWithBSplineCurve( points, polynomialDegree );
+        } ) );
+    }, "Returns the control points for a b-spline curve with given degree that interpolates the given points");
+    m.def( "interpolateWithBSplineCurveAsync", []( const std::vector<cie::splinekernel::python::DoubleArray>& interpolationPoints, size_t polynomialDegree )
+    {
+        auto future = cie::splinekernel::runAsync( [points = cie::splinekernel::python::toControlPoints2D( interpolationPoints ), polynomialDegree]( )
+        {
+            return cie::splinekernel::interpolateWithBSplineCurve( points, polynomialDegree );
+        } );
+
+        return cie::splinekernel::python::InterpolationFuture( std::move( future ), &cie::splinekernel::python::interpolationToPython );
+    }, "Same as interpolateWithBSplineCurve, but runs on the threads of the library and returns an InterpolationFuture" );
+    m.def( "interpolateWithBSplineCurveND", []( const std::vector<cie::splinekernel::python::DoubleArray>& interpolationPoints,
+                                                size_t polynomialDegree, size_t numberOfGeometricComponents )
+    {
+        cie::splinekernel::ControlPointsND points = cie::splinekernel::python::toVectors( interpolationPoints );
+
+        return cie::splinekernel::python::toNumpy( cie::splinekernel::python::withoutGil( [&]( )
+        {
+            return cie::splinekernel::interpolateWithBSplineCurveND( points, polynomialDegree, numberOfGeometricComponents );
+        } ) );
+    }, "Same as interpolateWithBSplineCurve for points with any number of components",
+           pybind11::arg( "interpolationPoints" ), pybind11::arg( "polynomialDegree" ), pybind11::arg( "numberOfGeometricComponents" ) = 0 );
+    m.def( "approximateWithBSplineCurve", []( const std::vector<cie::splinekernel::python::DoubleArray>& interpolationPoints,
+                                              size_t polynomialDegree, size_t numberOfControlPoints, const std::vector<double>& weights )
+    {
+        cie::splinekernel::ControlPoints2D points = cie::splinekernel::python::toControlPoints2D( interpolationPoints );
+
+        return cie::splinekernel::python::toNumpy( cie::splinekernel::python::withoutGil( [&]( )
+        {
+            return cie::splinekernel::approximateWithBSplineCurve( points, polynomialDegree, numberOfControlPoints, weights );
+        } ) );
+    }, "Returns the control points for a b-spline curve with given degree and number of control points approximating the given points",
+           pybind11::arg( "interpolationPoints" ), pybind11::arg( "polynomialDegree" ), pybind11::arg( "numberOfControlPoints" ),
+           pybind11::arg( "weights" ) = std::vector<double>( ) );
+    m.def( "approximateWithBSplineCurveND", []( const std::vector<cie::splinekernel::python::DoubleArray>& interpolationPoints,
+                                                size_t polynomialDegree, size_t numberOfControlPoints, const std::vector<double>& weights,
+                                                size_t numberOfGeometricComponents )
+    {
+        cie::splinekernel::ControlPointsND points = cie::splinekernel::python::toVectors( interpolationPoints );
+
+        return cie::splinekernel::python::toNumpy( cie::splinekernel::python::withoutGil( [&]( )
+        {
+            return cie::splinekernel::approximateWithBSplineCurveND( points, polynomialDegree, numberOfControlPoints,
+                                                                     weights, numberOfGeometricComponents );
+        } ) );
+    }, "Same as approximateWithBSplineCurve for points with any number of components",
+           pybind11::arg( "interpolationPoints" ), pybind11::arg( "polynomialDegree" ), pybind11::arg( "numberOfControlPoints" ),
+           pybind11::arg( "weights" ) = std::vector<double>( ), pybind11::arg( "numberOfGeometricComponents" ) = 0 );
+    m.def( "knotVectorForFitting", &cie::splinekernel::knotVectorForFitting,
+           "Knot vector for interpolating or approximating values at the given parameter positions" );
+    m.def( "fitBSplineSurface", &cie::splinekernel::fitBSplineSurface, "Control points fitting gridded values with the given fits in r and s",
+           pybind11::call_guard<pybind11::gil_scoped_release>( ) );
+    m.def( "interpolateWithBSplineSurface", []( const std::array<std::vector<double>, 2>& parameterPositions,
+                                                const cie::splinekernel::VectorOfMatrices& gridPoints, std::array<size_t, 2> polynomialDegrees )
+    {
+        return cie::splinekernel::python::surfaceFitToPython( cie::splinekernel::python::withoutGil( [&]( )
+        {
+            return cie::splinekernel::interpolateWithBSplineSurface( parameterPositions, gridPoints, polynomialDegrees );
+        } ) );
+    }, "Returns control points and knot vectors of the surface interpolating the gridded values at the given parameter positions" );
+    m.def( "interpolateWithBSplineSurface", []( const cie::splinekernel::VectorOfMatrices& gridPoints, std::array<size_t, 2> polynomialDegrees )
+    {
+        return cie::splinekernel::python::surfaceFitToPython( cie::splinekernel::python::withoutGil( [&]( )
+        {
+            return cie::splinekernel::interpolateWithBSplineSurface( gridPoints, polynomialDegrees );
+        } ) );
+    }, "Same as above with equidistant parameter positions" );
+    m.def( "approximateWithBSplineSurface", []( const std::array<std::vector<double>, 2>& parameterPositions,
+                                                const cie::splinekernel::VectorOfMatrices& gridPoints, std::array<size_t, 2> polynomialDegrees,
+                                                std::array<size_t, 2> numberOfControlPoints )
+    {
+        return cie::splinekernel::python::surfaceFitToPython( cie::splinekernel::python::withoutGil( [&]( )
+        {
+            return cie::splinekernel::approximateWithBSplineSurface( parameterPositions, gridPoints, polynomialDegrees, numberOfControlPoints );
+        } ) );
+    }, "Returns control points and knot vectors of the least squares surface with the given number of control points" );
+    m.def( "approximateWithBSplineSurface", []( const cie::splinekernel::VectorOfMatrices& gridPoints, std::array<size_t, 2> polynomialDegrees,
+                                                std::array<size_t, 2> numberOfControlPoints )
+    {
+        return cie::splinekernel::python::surfaceFitToPython( cie::splinekernel::python::withoutGil( [&]( )
+        {
+            return cie::splinekernel::approximateWithBSplineSurface( gridPoints, polynomialDegrees, numberOfControlPoints );
+        } ) );
+    }, "Same as above with equidistant parameter positions" );
 
 }
@@ -26,16 +26,19 @@ controlPointGrid = numpy.transpose( numpy.array( controlPointGrid ), ( 2, 0, 1 )
 numberOfSamples = ( numberOfSamplesInR, numberOfSamplesInS )
 knotVectors = ( knotVectorR, knotVectorS )
 
-xyz = pysplinekernel.evaluateSurface( knotVectors, controlPointGrid, numberOfSamples )
+# Values, partial derivatives and unit normals computed in one sweep
+surface = pysplinekernel.evaluateSurfaceDerivatives( knotVectors, controlPointGrid, numberOfSamples )
+
+xyz = surface["values"]
+normals = surface["normals"]
 
 # Plot surface (https://matplotlib.org/mpl_toolkits/mplot3d/tutorial.html)
 fig = plt.figure( )
 ax = fig.gca( projection='3d' )
 
-# Compute gradient of z coordinate to add some nice colors to the plot
-gradientX, gradientY = numpy.gradient( xyz[2] )
-gradientMagnitude = numpy.sqrt( gradientX**2 + gradientY**2 ) 
-colorMap = colormap.jet( gradientMagnitude / numpy.max( gradientMagnitude ) )
+# Color by the slope of the surface, i.e. the sine of the angle between normal and z-axis
+slope = numpy.sqrt( numpy.maximum( 1.0 - normals[2]**2, 0.0 ) )
+colorMap = colormap.jet( slope / numpy.max( slope ) )
 
 stepsize = 1
 
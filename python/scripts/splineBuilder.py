@@ -161,20 +161,26 @@ class Splinekernel:
         self.knotVector = []
         self.samplePoints = []
         self.curvePoints = [[],[]]
+        self.interpolator = pysplinekernel.IncrementalInterpolator(self.polynomialOrder, 2)
         
     # CALCULATION -------------------------------------------------------------
     def getSamplePoints(self):
         return np.linspace(0.0, 1.0, (len(self.interpolationPoints[0])-1)*10 )
     
+    def rebuildInterpolator(self):
+        self.interpolator = pysplinekernel.IncrementalInterpolator(self.polynomialOrder, 2)
+        for x, y in zip(self.interpolationPoints[0], self.interpolationPoints[1]):
+            self.interpolator.append([x, y])
+    
     def updateSpline(self, lastPoint=[]):
+        # Polynomial degree changed
+        if self.interpolator.polynomialDegree() != self.polynomialOrder:
+            self.rebuildInterpolator()
+        # Only the last rows of the interpolation matrix are updated
         if lastPoint != []:
-            self.controlPoints, self.knotVector = pysplinekernel.interpolateWithBSplineCurve(
-                    [self.interpolationPoints[0]+[lastPoint[0]], self.interpolationPoints[1]+[lastPoint[1]]],
-                    self.polynomialOrder)
+            self.controlPoints, self.knotVector = self.interpolator.preview(lastPoint)
         else:
-            self.controlPoints, self.knotVector = pysplinekernel.interpolateWithBSplineCurve(
-                    self.interpolationPoints,
-                    self.polynomialOrder)
+            self.controlPoints, self.knotVector = self.interpolator.interpolate()
     
     def updatePoints(self):
         x, y = pysplinekernel.evaluate2DCurveDeBoor(
@@ -190,14 +196,17 @@ class Splinekernel:
             if point[0] != self.interpolationPoints[0][-1] and point[1] != self.interpolationPoints[1][-1]:
                 self.interpolationPoints[0].append(point[0])
                 self.interpolationPoints[1].append(point[1])
+                self.interpolator.append(point)
         else:
             self.interpolationPoints[0].append(point[0])
             self.interpolationPoints[1].append(point[1])
+            self.interpolator.append(point)
         
     def pop(self):
         if len(self.interpolationPoints[0]) > 0:
             self.interpolationPoints[0] = self.interpolationPoints[0][:-1]
             self.interpolationPoints[1] = self.interpolationPoints[1][:-1]
+            self.rebuildInterpolator()
     
     def getPoints(self,lastPoint=[]):
         if len(self.interpolationPoints[0]) + len(lastPoint)/2 > self.polynomialOrder:
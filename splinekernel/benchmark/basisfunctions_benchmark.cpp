@@ -0,0 +1,98 @@
+#include "benchmark.hpp"
+#include "basisfunctions.hpp"
+#include "curve.hpp"
+
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace benchmark
+{
+namespace
+{
+
+// The recursive evaluation is exponential in the degree, so it uses smaller sweeps
+const bool registered =
+    registerBenchmark( "evaluateBSplineBasis", []( const Parameters& parameters )
+    {
+        size_t n = parameters.numberOfControlPoints;
+        size_t p = parameters.polynomialDegree;
+
+        std::vector<double> knotVector = openKnotVector( n, p );
+        std::vector<double> t = linspace( parameters.numberOfSamples );
+
+        auto run = [=]( )
+        {
+            double sum = 0.0;
+
+            // One of the functions that are nonzero at the sample
+            for( size_t i = 0; i < t.size( ); ++i )
+            {
+                size_t span = findKnotSpan( t[i], n, knotVector );
+
+                sum += evaluateBSplineBasis( t[i], span - i % ( p + 1 ), p, knotVector );
+            }
+
+            keep( sum );
+        };
+
+        return Case { run, parameters.numberOfSamples };
+    }, sweep( { 3, 100, 10000 }, { 1, 2, 3, 4, 5 }, { 10, 100, 1000 }, { 1000, 10000, 100000 } ) ) &&
+
+    registerBenchmark( "evaluateNonzeroBSplineBasis", []( const Parameters& parameters )
+    {
+        size_t n = parameters.numberOfControlPoints;
+        size_t p = parameters.polynomialDegree;
+
+        std::vector<double> knotVector = openKnotVector( n, p );
+        std::vector<double> t = linspace( parameters.numberOfSamples );
+        std::vector<size_t> spans;
+
+        for( double value : t )
+        {
+            spans.push_back( findKnotSpan( value, n, knotVector ) );
+        }
+
+        auto run = [=]( )
+        {
+            std::vector<double> N( p + 1 );
+
+            double sum = 0.0;
+
+            for( size_t i = 0; i < t.size( ); ++i )
+            {
+                evaluateNonzeroBSplineBasis( t[i], spans[i], p, knotVector, N.data( ) );
+
+                sum += N[i % ( p + 1 )];
+            }
+
+            keep( sum );
+        };
+
+        return Case { run, parameters.numberOfSamples };
+    }, sweep( { 3, 100, 100000 }, { 1, 2, 3, 4, 5, 7 }, { 10, 1000, 100000 }, { 1000, 100000, 1000000 } ) ) &&
+
+    registerBenchmark( "evaluateBSplineBasisDerivatives", []( const Parameters& parameters )
+    {
+        size_t n = parameters.numberOfControlPoints;
+        size_t p = parameters.polynomialDegree;
+
+        std::vector<double> knotVector = openKnotVector( n, p );
+        std::vector<double> t = linspace( parameters.numberOfSamples );
+
+        auto run = [=]( )
+        {
+            BasisFunctionDerivatives derivatives = evaluateBSplineBasisDerivatives( t, p, 1, knotVector );
+
+            keep( derivatives );
+        };
+
+        return Case { run, parameters.numberOfSamples };
+    }, sweep( { 3, 100, 100000 }, { 1, 2, 3, 4, 5, 7 }, { 10, 1000, 100000 }, { 1000, 100000, 1000000 } ) );
+
+} // namespace
+} // namespace benchmark
+} // namespace splinekernel
+} // namespace cie
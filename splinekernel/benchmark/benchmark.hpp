@@ -0,0 +1,70 @@
+#ifndef CIE_BENCHMARK_HPP
+#define CIE_BENCHMARK_HPP
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "stddef.h"
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace benchmark
+{
+
+//! Parameters of one benchmark case. Surfaces use the same values in both directions.
+struct Parameters
+{
+    size_t polynomialDegree;
+    size_t numberOfControlPoints;
+    size_t numberOfSamples;
+};
+
+//! A prepared benchmark case: run( ) is timed repeatedly and processes numberOfItems items per call.
+struct Case
+{
+    std::function<void( )> run;
+    size_t numberOfItems;
+};
+
+//! Creates the input data for the given parameters outside of the timed region.
+using Setup = std::function<Case( const Parameters& )>;
+
+/*! Registers a benchmark that is run for every parameter combination in sweep. Meant to be
+ *  called during static initialization of the benchmark files, returns true.
+ */
+bool registerBenchmark( const std::string& name,
+                        Setup setup,
+                        const std::vector<Parameters>& sweep );
+
+/*! Varies one parameter at a time around base: first the degrees, then the numbers of control
+ *  points and then the numbers of samples, keeping the other two parameters at their base values.
+ */
+std::vector<Parameters> sweep( Parameters base,
+                               const std::vector<size_t>& degrees,
+                               const std::vector<size_t>& numbersOfControlPoints,
+                               const std::vector<size_t>& numbersOfSamples );
+
+//! Open knot vector on [0, 1] with slightly irregular inner knots, or equidistant ones if uniform.
+std::vector<double> openKnotVector( size_t numberOfControlPoints,
+                                    size_t polynomialDegree,
+                                    bool uniform = false );
+
+//! numberOfValues equidistant values in [0, 1].
+std::vector<double> linspace( size_t numberOfValues );
+
+//! Keeps the compiler from optimizing away computations whose results are otherwise unused.
+void doNotOptimize( const void* pointer );
+
+template<typename T>
+void keep( const T& value )
+{
+    doNotOptimize( &value );
+}
+
+} // namespace benchmark
+} // namespace splinekernel
+} // namespace cie
+
+#endif // CIE_BENCHMARK_HPP
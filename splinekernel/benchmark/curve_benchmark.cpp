@@ -0,0 +1,99 @@
+#include "benchmark.hpp"
+#include "curve.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace benchmark
+{
+namespace
+{
+
+std::vector<Parameters> curveSweep( )
+{
+    return sweep( { 3, 100, 100000 }, { 1, 2, 3, 4, 5, 7 }, { 10, 100, 1000, 10000, 100000 },
+                  { 1000, 10000, 100000, 1000000 } );
+}
+
+template<typename Evaluator>
+Case curveCase( const Parameters& parameters, Evaluator evaluator, bool uniform )
+{
+    size_t n = parameters.numberOfControlPoints;
+
+    std::vector<double> knotVector = openKnotVector( n, parameters.polynomialDegree, uniform );
+    std::vector<double> t = linspace( parameters.numberOfSamples );
+    std::vector<double> x( n ), y( n );
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        x[i] = static_cast<double>( i ) / n;
+        y[i] = std::sin( 0.1 * i );
+    }
+
+    auto run = [=]( )
+    {
+        std::array<std::vector<double>, 2> curve = evaluator( t, x, y, knotVector );
+
+        keep( curve );
+    };
+
+    return { run, parameters.numberOfSamples };
+}
+
+using CurveEvaluator = std::array<std::vector<double>, 2>( * )( const std::vector<double>&, const std::vector<double>&,
+                                                                 const std::vector<double>&, const std::vector<double>& );
+
+const bool registered =
+    registerBenchmark( "evaluate2DCurve", []( const Parameters& parameters )
+    {
+        return curveCase( parameters, static_cast<CurveEvaluator>( &evaluate2DCurve ), false );
+    }, curveSweep( ) ) &&
+    registerBenchmark( "evaluate2DCurve/uniform", []( const Parameters& parameters )
+    {
+        return curveCase( parameters, static_cast<CurveEvaluator>( &evaluate2DCurve ), true );
+    }, curveSweep( ) ) &&
+    registerBenchmark( "evaluate2DCurveDeBoor", []( const Parameters& parameters )
+    {
+        return curveCase( parameters, static_cast<CurveEvaluator>( &evaluate2DCurveDeBoor ), false );
+    }, curveSweep( ) ) &&
+    registerBenchmark( "stream2DCurve", []( const Parameters& parameters )
+    {
+        size_t n = parameters.numberOfControlPoints;
+        size_t s = parameters.numberOfSamples;
+
+        std::vector<double> knotVector = openKnotVector( n, parameters.polynomialDegree );
+        std::vector<double> x( n ), y( n );
+
+        for( size_t i = 0; i < n; ++i )
+        {
+            x[i] = static_cast<double>( i ) / n;
+            y[i] = std::sin( 0.1 * i );
+        }
+
+        // The sink only reduces the samples, such that the timing excludes any output
+        auto run = [=]( )
+        {
+            double sum = 0.0;
+
+            stream2DCurve( 0.0, 1.0, s, x, y, knotVector, [&]( size_t, size_t size, const double*, const double* curveX, const double* curveY )
+            {
+                for( size_t i = 0; i < size; ++i )
+                {
+                    sum += curveX[i] + curveY[i];
+                }
+            } );
+
+            keep( sum );
+        };
+
+        return Case { run, s };
+    }, sweep( { 3, 100, 1000000 }, { 1, 3, 5 }, { 10, 1000, 100000 }, { 10000, 1000000, 10000000 } ) );
+
+} // namespace
+} // namespace benchmark
+} // namespace splinekernel
+} // namespace cie
@@ -0,0 +1,107 @@
+#include "benchmark.hpp"
+#include "fitting.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace benchmark
+{
+namespace
+{
+
+// Height field sampled on a square grid
+linalg::Matrix heightField( size_t numberOfPoints )
+{
+    linalg::Matrix z( numberOfPoints, numberOfPoints, 0.0 );
+
+    for( size_t i = 0; i < numberOfPoints; ++i )
+    {
+        for( size_t j = 0; j < numberOfPoints; ++j )
+        {
+            z( i, j ) = std::sin( 0.01 * i ) * std::cos( 0.02 * j ) + 0.1 * std::sin( 0.3 * i * j );
+        }
+    }
+
+    return z;
+}
+
+// Samples of a noisy trace, e.g. from a sensor
+ControlPoints2D trace( size_t numberOfPoints )
+{
+    ControlPoints2D points;
+
+    for( size_t i = 0; i < numberOfPoints; ++i )
+    {
+        double t = static_cast<double>( i ) / numberOfPoints;
+
+        points[0].push_back( t );
+        points[1].push_back( std::sin( 20.0 * t ) + 0.01 * std::sin( 12.9898 * i ) );
+    }
+
+    return points;
+}
+
+const bool registered =
+    // Items are points, approximated by numberOfControlPoints control points
+    registerBenchmark( "approximateWithBSplineCurve", []( const Parameters& parameters )
+    {
+        ControlPoints2D points = trace( parameters.numberOfSamples );
+
+        size_t n = parameters.numberOfControlPoints;
+        size_t p = parameters.polynomialDegree;
+
+        auto run = [=]( )
+        {
+            ControlPointsAndKnotVector result = approximateWithBSplineCurve( points, p, n );
+
+            keep( result );
+        };
+
+        return Case { run, parameters.numberOfSamples };
+    }, sweep( { 3, 1000, 100000 }, { 1, 2, 3, 5, 7 }, { 10, 1000, 10000 }, { 10000, 100000, 1000000 } ) ) &&
+
+    // Items are grid points, the number of samples is not used
+    registerBenchmark( "interpolateWithBSplineSurface", []( const Parameters& parameters )
+    {
+        size_t n = parameters.numberOfControlPoints;
+        size_t p = parameters.polynomialDegree;
+
+        VectorOfMatrices gridPoints { heightField( n ) };
+
+        auto run = [=]( )
+        {
+            SurfaceControlPointsAndKnotVectors result = interpolateWithBSplineSurface( gridPoints, { p, p } );
+
+            keep( result.first );
+        };
+
+        return Case { run, n * n };
+    }, sweep( { 3, 500, 0 }, { 1, 2, 3, 4, 5, 7 }, { 10, 100, 1000, 4000 }, { } ) ) &&
+
+    // Items are grid points, the grid has numberOfSamples points per direction
+    registerBenchmark( "approximateWithBSplineSurface", []( const Parameters& parameters )
+    {
+        size_t n = parameters.numberOfControlPoints;
+        size_t s = parameters.numberOfSamples;
+        size_t p = parameters.polynomialDegree;
+
+        VectorOfMatrices gridPoints { heightField( s ) };
+
+        auto run = [=]( )
+        {
+            SurfaceControlPointsAndKnotVectors result = approximateWithBSplineSurface( gridPoints, { p, p }, { n, n } );
+
+            keep( result.first );
+        };
+
+        return Case { run, s * s };
+    }, sweep( { 3, 50, 1000 }, { 1, 2, 3, 5 }, { 10, 50, 200 }, { 200, 1000, 4000 } ) );
+
+} // namespace
+} // namespace benchmark
+} // namespace splinekernel
+} // namespace cie
@@ -0,0 +1,84 @@
+#include "benchmark.hpp"
+#include "interpolation.hpp"
+#include "incrementalinterpolation.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace benchmark
+{
+namespace
+{
+
+// Points on a spiral, the number of points equals the number of control points
+ControlPoints2D spiral( size_t numberOfPoints )
+{
+    ControlPoints2D points;
+
+    for( size_t i = 0; i < numberOfPoints; ++i )
+    {
+        double phi = 0.05 * i;
+
+        points[0].push_back( ( 1.0 + 0.1 * phi ) * std::cos( phi ) );
+        points[1].push_back( ( 1.0 + 0.1 * phi ) * std::sin( phi ) );
+    }
+
+    return points;
+}
+
+// Items are interpolation points, the number of samples is not used
+std::vector<Parameters> interpolationSweep( )
+{
+    return sweep( { 3, 1000, 0 }, { 1, 2, 3, 4, 5, 7 }, { 10, 100, 1000, 10000, 100000 }, { } );
+}
+
+const bool registered =
+    registerBenchmark( "interpolateWithBSplineCurve", []( const Parameters& parameters )
+    {
+        ControlPoints2D points = spiral( parameters.numberOfControlPoints );
+        size_t p = parameters.polynomialDegree;
+
+        auto run = [=]( )
+        {
+            ControlPointsAndKnotVector result = interpolateWithBSplineCurve( points, p );
+
+            keep( result );
+        };
+
+        return Case { run, parameters.numberOfControlPoints };
+    }, interpolationSweep( ) ) &&
+
+    registerBenchmark( "IncrementalInterpolator", []( const Parameters& parameters )
+    {
+        ControlPoints2D points = spiral( parameters.numberOfControlPoints );
+        size_t p = parameters.polynomialDegree;
+
+        // Appends all points and interpolates after each, as an interactive editor would
+        auto run = [=]( )
+        {
+            IncrementalInterpolator interpolator( p, 2 );
+
+            for( size_t i = 0; i < points[0].size( ); ++i )
+            {
+                interpolator.append( { points[0][i], points[1][i] } );
+
+                if( i >= p )
+                {
+                    ControlPointsNDAndKnotVector result = interpolator.interpolate( );
+
+                    keep( result );
+                }
+            }
+        };
+
+        return Case { run, parameters.numberOfControlPoints };
+    }, sweep( { 3, 100, 0 }, { 1, 3, 5 }, { 10, 100, 1000 }, { } ) );
+
+} // namespace
+} // namespace benchmark
+} // namespace splinekernel
+} // namespace cie
@@ -0,0 +1,372 @@
+#include "benchmark.hpp"
+#include "threadpool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace benchmark
+{
+namespace detail
+{
+
+struct Benchmark
+{
+    std::string name;
+    Setup setup;
+    std::vector<Parameters> sweep;
+};
+
+std::vector<Benchmark>& registry( )
+{
+    static std::vector<Benchmark> benchmarks;
+
+    return benchmarks;
+}
+
+struct Options
+{
+    std::string filter;
+    std::string output;
+    std::vector<size_t> threads;
+    double minimumTime = 0.2;
+    size_t repetitions = 3;
+};
+
+std::vector<size_t> parseList( const std::string& list )
+{
+    std::vector<size_t> values;
+    std::stringstream stream( list );
+    std::string value;
+
+    while( std::getline( stream, value, ',' ) )
+    {
+        values.push_back( std::stoul( value ) );
+    }
+
+    return values;
+}
+
+Options parseOptions( int argc, char** argv )
+{
+    Options options;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string argument = argv[i];
+
+        if( argument == "--help" )
+        {
+            std::cout << "Usage: splinekernel_benchmarks [options]\n"
+                      << "  --filter <text>         Only run benchmarks whose name contains text\n"
+                      << "  --threads <n1,n2,...>   Numbers of threads to run each case with (default: 1 and all)\n"
+                      << "  --min-time <seconds>    Minimum time measured per repetition (default: 0.2)\n"
+                      << "  --repetitions <n>       Number of measurements per case (default: 3)\n"
+                      << "  --output <file>         Write the JSON report to file instead of stdout\n";
+
+            std::exit( 0 );
+        }
+
+        if( i + 1 == argc )
+        {
+            throw std::runtime_error( "Missing value for option " + argument );
+        }
+
+        std::string value = argv[++i];
+
+        if( argument == "--filter" ) options.filter = value;
+        else if( argument == "--threads" ) options.threads = parseList( value );
+        else if( argument == "--min-time" ) options.minimumTime = std::stod( value );
+        else if( argument == "--repetitions" ) options.repetitions = std::max( std::stoul( value ), 1ul );
+        else if( argument == "--output" ) options.output = value;
+        else throw std::runtime_error( "Unknown option " + argument );
+    }
+
+    if( options.threads.empty( ) )
+    {
+        size_t hardwareThreads = std::max( std::thread::hardware_concurrency( ), 1u );
+
+        options.threads = hardwareThreads > 1 ? std::vector<size_t>{ 1, hardwareThreads } : std::vector<size_t>{ 1 };
+    }
+
+    return options;
+}
+
+double seconds( std::chrono::steady_clock::duration duration )
+{
+    return std::chrono::duration<double>( duration ).count( );
+}
+
+struct Measurement
+{
+    size_t iterations;
+    std::vector<double> nsPerIteration;
+};
+
+// Chooses the number of iterations from a first run, then times each repetition separately
+Measurement measure( const Case& benchmarkCase, const Options& options )
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto start = Clock::now( );
+
+    benchmarkCase.run( );
+
+    double firstRun = std::max( seconds( Clock::now( ) - start ), 1e-9 );
+
+    Measurement measurement;
+
+    measurement.iterations = static_cast<size_t>( std::ceil( options.minimumTime / firstRun ) );
+
+    for( size_t repetition = 0; repetition < options.repetitions; ++repetition )
+    {
+        start = Clock::now( );
+
+        for( size_t iteration = 0; iteration < measurement.iterations; ++iteration )
+        {
+            benchmarkCase.run( );
+        }
+
+        double time = seconds( Clock::now( ) - start );
+
+        measurement.nsPerIteration.push_back( 1e9 * time / measurement.iterations );
+    }
+
+    std::sort( measurement.nsPerIteration.begin( ), measurement.nsPerIteration.end( ) );
+
+    return measurement;
+}
+
+void writeContext( std::ostream& out )
+{
+    std::time_t now = std::time( nullptr );
+
+    char date[32];
+
+    std::strftime( date, sizeof( date ), "%Y-%m-%dT%H:%M:%S", std::localtime( &now ) );
+
+    out << "  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"hardwareConcurrency\": " << std::thread::hardware_concurrency( ) << ",\n"
+#ifdef __VERSION__
+        << "    \"compiler\": \"" << __VERSION__ << "\",\n"
+#endif
+#ifdef NDEBUG
+        << "    \"assertions\": false\n"
+#else
+        << "    \"assertions\": true\n"
+#endif
+        << "  },\n";
+}
+
+} // namespace detail
+
+bool registerBenchmark( const std::string& name,
+                        Setup setup,
+                        const std::vector<Parameters>& sweep )
+{
+    detail::registry( ).push_back( { name, setup, sweep } );
+
+    return true;
+}
+
+std::vector<Parameters> sweep( Parameters base,
+                               const std::vector<size_t>& degrees,
+                               const std::vector<size_t>& numbersOfControlPoints,
+                               const std::vector<size_t>& numbersOfSamples )
+{
+    std::vector<Parameters> parameters;
+
+    auto add = [&]( Parameters value )
+    {
+        auto equal = [&]( const Parameters& other )
+        {
+            return other.polynomialDegree == value.polynomialDegree &&
+                   other.numberOfControlPoints == value.numberOfControlPoints &&
+                   other.numberOfSamples == value.numberOfSamples;
+        };
+
+        if( std::none_of( parameters.begin( ), parameters.end( ), equal ) )
+        {
+            parameters.push_back( value );
+        }
+    };
+
+    for( size_t p : degrees )
+    {
+        add( { p, std::max( base.numberOfControlPoints, p + 1 ), base.numberOfSamples } );
+    }
+
+    for( size_t n : numbersOfControlPoints )
+    {
+        add( { base.polynomialDegree, std::max( n, base.polynomialDegree + 1 ), base.numberOfSamples } );
+    }
+
+    for( size_t s : numbersOfSamples )
+    {
+        add( { base.polynomialDegree, base.numberOfControlPoints, s } );
+    }
+
+    return parameters;
+}
+
+std::vector<double> openKnotVector( size_t numberOfControlPoints,
+                                    size_t polynomialDegree,
+                                    bool uniform )
+{
+    size_t numberOfSpans = numberOfControlPoints - polynomialDegree;
+
+    std::vector<double> knotVector( polynomialDegree + 1, 0.0 );
+
+    for( size_t i = 1; i < numberOfSpans; ++i )
+    {
+        double t = static_cast<double>( i ) / numberOfSpans;
+
+        // Deterministic irregularity of up to a quarter of the span length
+        double shift = uniform ? 0.0 : 0.25 * std::sin( 12.9898 * i ) / numberOfSpans;
+
+        knotVector.push_back( t + shift );
+    }
+
+    knotVector.resize( numberOfControlPoints + polynomialDegree + 1, 1.0 );
+
+    return knotVector;
+}
+
+std::vector<double> linspace( size_t numberOfValues )
+{
+    std::vector<double> values( numberOfValues, 0.0 );
+
+    for( size_t i = 1; i < numberOfValues; ++i )
+    {
+        values[i] = static_cast<double>( i ) / ( numberOfValues - 1 );
+    }
+
+    return values;
+}
+
+void doNotOptimize( const void* pointer )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+    asm volatile( "" : : "g"( pointer ) : "memory" );
+#else
+    static const void* volatile sink;
+
+    sink = pointer;
+#endif
+}
+
+} // namespace benchmark
+} // namespace splinekernel
+} // namespace cie
+
+int main( int argc, char** argv )
+{
+    using namespace cie::splinekernel;
+    using namespace cie::splinekernel::benchmark;
+
+    detail::Options options;
+
+    try
+    {
+        options = detail::parseOptions( argc, argv );
+    }
+    catch( std::exception& exception )
+    {
+        std::cerr << exception.what( ) << std::endl;
+
+        return 1;
+    }
+
+    std::ofstream file;
+
+    if( !options.output.empty( ) )
+    {
+        file.open( options.output );
+
+        if( !file )
+        {
+            std::cerr << "Could not open " << options.output << std::endl;
+
+            return 1;
+        }
+    }
+
+    std::ostream& out = options.output.empty( ) ? std::cout : file;
+
+    size_t initialNumberOfThreads = getNumberOfThreads( );
+
+    out << "{\n";
+
+    detail::writeContext( out );
+
+    out << "  \"benchmarks\": [";
+
+    bool first = true;
+
+    for( const auto& benchmark : detail::registry( ) )
+    {
+        if( benchmark.name.find( options.filter ) == std::string::npos )
+        {
+            continue;
+        }
+
+        for( const auto& parameters : benchmark.sweep )
+        {
+            Case benchmarkCase = benchmark.setup( parameters );
+
+            for( size_t numberOfThreads : options.threads )
+            {
+                setNumberOfThreads( numberOfThreads );
+
+                detail::Measurement measurement = detail::measure( benchmarkCase, options );
+
+                double median = measurement.nsPerIteration[measurement.nsPerIteration.size( ) / 2];
+                double minimum = measurement.nsPerIteration.front( );
+
+                double items = static_cast<double>( std::max( benchmarkCase.numberOfItems, size_t { 1 } ) );
+
+                out << ( first ? "\n" : ",\n" ) << std::setprecision( 6 )
+                    << "    { \"name\": \"" << benchmark.name << "\""
+                    << ", \"polynomialDegree\": " << parameters.polynomialDegree
+                    << ", \"numberOfControlPoints\": " << parameters.numberOfControlPoints
+                    << ", \"numberOfSamples\": " << parameters.numberOfSamples
+                    << ", \"numberOfThreads\": " << numberOfThreads
+                    << ", \"iterations\": " << measurement.iterations
+                    << ", \"repetitions\": " << measurement.nsPerIteration.size( )
+                    << ", \"nsPerIteration\": " << median
+                    << ", \"minimumNsPerIteration\": " << minimum
+                    << ", \"nsPerSample\": " << median / items << " }";
+
+                first = false;
+
+                // Progress for the human watching
+                std::cerr << std::left << std::setw( 36 ) << benchmark.name
+                          << " p = " << std::setw( 2 ) << parameters.polynomialDegree
+                          << " n = " << std::setw( 7 ) << parameters.numberOfControlPoints
+                          << " samples = " << std::setw( 8 ) << parameters.numberOfSamples
+                          << " threads = " << std::setw( 3 ) << numberOfThreads
+                          << std::right << std::setw( 12 ) << std::setprecision( 4 )
+                          << median / items << " ns/sample" << std::endl;
+            }
+        }
+    }
+
+    out << "\n  ]\n}\n";
+
+    setNumberOfThreads( initialNumberOfThreads );
+
+    return 0;
+}
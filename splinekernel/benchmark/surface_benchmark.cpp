@@ -0,0 +1,131 @@
+#include "benchmark.hpp"
+#include "surface.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace benchmark
+{
+namespace
+{
+
+// Control points and samples per direction, items are all samples of the grid
+std::vector<Parameters> surfaceSweep( )
+{
+    return sweep( { 3, 50, 500 }, { 1, 2, 3, 4, 5, 7 }, { 10, 50, 200, 1000 }, { 50, 200, 500, 1000 } );
+}
+
+VectorOfMatrices controlPointGrid( size_t numberOfControlPoints )
+{
+    size_t n = numberOfControlPoints;
+
+    VectorOfMatrices controlPoints( 3, linalg::Matrix( n, n, 0.0 ) );
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        for( size_t j = 0; j < n; ++j )
+        {
+            controlPoints[0]( i, j ) = static_cast<double>( i ) / n;
+            controlPoints[1]( i, j ) = static_cast<double>( j ) / n;
+            controlPoints[2]( i, j ) = std::sin( 0.1 * i ) * std::cos( 0.2 * j );
+        }
+    }
+
+    return controlPoints;
+}
+
+const bool registered =
+    registerBenchmark( "evaluateSurface", []( const Parameters& parameters )
+    {
+        size_t n = parameters.numberOfControlPoints;
+        size_t s = parameters.numberOfSamples;
+
+        std::vector<double> knotVector = openKnotVector( n, parameters.polynomialDegree );
+        VectorOfMatrices controlPoints = controlPointGrid( n );
+
+        auto run = [=]( )
+        {
+            VectorOfMatrices surface = evaluateSurface( { knotVector, knotVector }, controlPoints, { s, s } );
+
+            keep( surface );
+        };
+
+        return Case { run, s * s };
+    }, surfaceSweep( ) ) &&
+
+    registerBenchmark( "evaluateSurface/EvaluationPlan", []( const Parameters& parameters )
+    {
+        size_t n = parameters.numberOfControlPoints;
+        size_t s = parameters.numberOfSamples;
+
+        std::vector<double> knotVector = openKnotVector( n, parameters.polynomialDegree );
+        VectorOfMatrices controlPoints = controlPointGrid( n );
+
+        // Basis functions are evaluated once outside of the timed region
+        EvaluationPlan plan( linspace( s ), n, knotVector );
+
+        std::array<EvaluationPlan, 2> plans { plan, plan };
+
+        auto run = [=]( )
+        {
+            VectorOfMatrices surface = evaluateSurface( plans, controlPoints );
+
+            keep( surface );
+        };
+
+        return Case { run, s * s };
+    }, surfaceSweep( ) ) &&
+
+    registerBenchmark( "evaluateSurfaceDerivatives", []( const Parameters& parameters )
+    {
+        size_t n = parameters.numberOfControlPoints;
+        size_t s = parameters.numberOfSamples;
+
+        std::vector<double> knotVector = openKnotVector( n, parameters.polynomialDegree );
+        VectorOfMatrices controlPoints = controlPointGrid( n );
+
+        auto run = [=]( )
+        {
+            SurfaceDerivatives surface = evaluateSurfaceDerivatives( { knotVector, knotVector }, controlPoints, { s, s } );
+
+            keep( surface.normals );
+        };
+
+        return Case { run, s * s };
+    }, surfaceSweep( ) ) &&
+
+    registerBenchmark( "evaluateSurfaceAtPoints", []( const Parameters& parameters )
+    {
+        size_t n = parameters.numberOfControlPoints;
+        size_t s = parameters.numberOfSamples;
+
+        std::vector<double> knotVector = openKnotVector( n, parameters.polynomialDegree );
+        VectorOfMatrices controlPoints = controlPointGrid( n );
+
+        // As many scattered points as the grids above have samples, in pseudo random order
+        std::vector<double> r( s * s ), t( s * s );
+
+        for( size_t i = 0; i < s * s; ++i )
+        {
+            r[i] = std::abs( std::sin( 12.9898 * i ) );
+            t[i] = std::abs( std::cos( 78.233 * i ) );
+        }
+
+        auto run = [=]( )
+        {
+            std::vector<std::vector<double>> values = evaluateSurfaceAtPoints( { knotVector, knotVector }, controlPoints, r, t );
+
+            keep( values );
+        };
+
+        return Case { run, s * s };
+    }, surfaceSweep( ) );
+
+} // namespace
+} // namespace benchmark
+} // namespace splinekernel
+} // namespace cie
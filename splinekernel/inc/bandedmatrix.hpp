@@ -0,0 +1,63 @@
+#ifndef CIE_BANDEDMATRIX_HPP
+#define CIE_BANDEDMATRIX_HPP
+
+#include <vector>
+#include "stddef.h"
+
+namespace cie
+{
+namespace splinekernel
+{
+
+/*! Square matrix that only stores the entries within a lower and an upper bandwidth around the
+ *  diagonal. Each row stores its lowerBandwidth + upperBandwidth + 1 entries contiguously.
+ */
+class BandedMatrix
+{
+public:
+    BandedMatrix( size_t size, size_t lowerBandwidth, size_t upperBandwidth );
+
+    size_t size( ) const;
+    size_t lowerBandwidth( ) const;
+    size_t upperBandwidth( ) const;
+
+    /*! Changes the number of rows and columns, keeping the leading rows. New rows are zero and
+     *  must be factorized before solving again. */
+    void resize( size_t size );
+
+    //! Access to the entry in row i and column j, which must lie within the band.
+    double operator()( size_t i, size_t j ) const;
+    double& operator()( size_t i, size_t j );
+
+    /*! Computes the LU decomposition in place without pivoting. This keeps the band structure and
+     *  is stable for totally positive matrices such as B-Spline collocation matrices. The
+     *  factorization proceeds row by row, each row only depending on the rows above. Rows before
+     *  firstRow are assumed to be factorized already, such that changes in the trailing rows
+     *  only require refactorizing these. Throws if a pivot is numerically zero relative to the
+     *  largest entry of its row, such that the result does not depend on the scale of the matrix.
+     */
+    void factorize( size_t firstRow = 0 );
+
+    /*! Solves the factorized system in place for multiple right hand sides.
+     *  @param rightHandSides Row-major size x numberOfRightHandSides block, such that all right
+     *                        hand side values of one row are contiguous
+     */
+    void solve( double* rightHandSides, size_t numberOfRightHandSides ) const;
+
+    //! Solves the factorized system for one right hand side.
+    std::vector<double> solve( const std::vector<double>& rightHandSide ) const;
+
+private:
+    size_t m_size;
+    size_t m_lowerBandwidth;
+    size_t m_upperBandwidth;
+
+    std::vector<double> m_data;
+
+    bool m_factorized;
+};
+
+} // namespace splinekernel
+} // namespace cie
+
+#endif // CIE_BANDEDMATRIX_HPP
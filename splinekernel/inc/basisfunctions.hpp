@@ -18,6 +18,66 @@ namespace splinekernel
  */
 double evaluateBSplineBasis( double t, size_t i, size_t p, const std::vector<double>& knotVector );
 
+/*! Evaluates all p + 1 B-Spline basis functions that are nonzero in the given knot span in one
+ *  non-recursive triangular pass (The NURBS Book, algorithm A2.2).
+ *  @param t The parametric coordinate
+ *  @param knotSpanIndex The knot span containing t, as returned by findKnotSpan
+ *  @param p The polynomial degree
+ *  @param knotVector
+ *  @param basisValues Target buffer of size p + 1, receiving N_{knotSpanIndex - p}, ..., N_{knotSpanIndex}
+ */
+void evaluateNonzeroBSplineBasis( double t,
+                                  size_t knotSpanIndex,
+                                  size_t p,
+                                  const std::vector<double>& knotVector,
+                                  double* basisValues );
+
+/*! Evaluates the p + 1 nonzero B-Spline basis functions in the given knot span and their first
+ *  numberOfDerivatives derivatives (The NURBS Book, algorithm A2.3).
+ *  @param basisDerivatives Target buffer of size ( numberOfDerivatives + 1 ) * ( p + 1 ). Row k
+ *                          holds the k-th derivatives of N_{knotSpanIndex - p}, ..., N_{knotSpanIndex}.
+ *  @param workspace Scratch buffer of size ( p + 1 ) * ( p + 3 )
+ */
+void evaluateNonzeroBSplineBasisDerivatives( double t,
+                                             size_t knotSpanIndex,
+                                             size_t p,
+                                             size_t numberOfDerivatives,
+                                             const std::vector<double>& knotVector,
+                                             double* basisDerivatives,
+                                             double* workspace );
+
+//! Nonzero basis functions and their derivatives at a set of parametric coordinates.
+struct BasisFunctionDerivatives
+{
+    size_t polynomialDegree = 0;
+    size_t numberOfDerivatives = 0;
+
+    //! The knot span index for each parametric coordinate
+    std::vector<size_t> knotSpans;
+
+    /*! One contiguous block of ( numberOfDerivatives + 1 ) x ( polynomialDegree + 1 ) values for
+     *  each parametric coordinate, laid out as in evaluateNonzeroBSplineBasisDerivatives. */
+    std::vector<double> values;
+
+    //! The k-th derivative of basis function knotSpans[iT] - p + i at the parametric coordinate iT
+    double operator()( size_t iT, size_t k, size_t i ) const
+    {
+        return values[( iT * ( numberOfDerivatives + 1 ) + k ) * ( polynomialDegree + 1 ) + i];
+    }
+};
+
+/*! Evaluates the nonzero basis functions and their first numberOfDerivatives derivatives at all
+ *  given parametric coordinates in a single sweep.
+ *  @param tCoordinates The parametric coordinates
+ *  @param p The polynomial degree
+ *  @param numberOfDerivatives The highest derivative to compute (0 gives only function values)
+ *  @param knotVector
+ */
+BasisFunctionDerivatives evaluateBSplineBasisDerivatives( const std::vector<double>& tCoordinates,
+                                                          size_t p,
+                                                          size_t numberOfDerivatives,
+                                                          const std::vector<double>& knotVector );
+
 } // namespace splinekernel
 } // namespace cie
 
@@ -0,0 +1,72 @@
+#ifndef CIE_BSPLINECURVE_HPP
+#define CIE_BSPLINECURVE_HPP
+
+#include <array>
+#include <vector>
+#include "stddef.h"
+
+#include "curve.hpp"
+#include "knotvector.hpp"
+
+namespace cie
+{
+namespace splinekernel
+{
+
+/*! A 2D B-Spline curve owning its control points and knot vector. The sizes and the knot vector
+ *  are validated once on construction and the derived knot vector data is cached, so evaluating
+ *  the curve repeatedly does not repeat this setup as evaluate2DCurve does on every call.
+ */
+class BSplineCurve
+{
+public:
+    BSplineCurve( const std::vector<double>& xCoordinates,
+                  const std::vector<double>& yCoordinates,
+                  const std::vector<double>& knotVector );
+
+    BSplineCurve( const std::vector<double>& xCoordinates,
+                  const std::vector<double>& yCoordinates,
+                  const KnotVector& knotVector );
+
+    size_t numberOfControlPoints( ) const;
+    size_t polynomialDegree( ) const;
+
+    const KnotVector& knotVector( ) const;
+
+    const std::vector<double>& xCoordinates( ) const;
+    const std::vector<double>& yCoordinates( ) const;
+
+    //! Evaluates the curve at one parametric coordinate within [lowerBound( ), upperBound( )] of the knot vector.
+    std::array<double, 2> evaluate( double t ) const;
+
+    //! Same as evaluate2DCurve with the control points and knot vector of this curve, which has the same bounds.
+    std::array<std::vector<double>, 2> evaluate( const std::vector<double>& tCoordinates ) const;
+
+    //! Same as above, but reading from and writing to existing arrays of numberOfSamples values.
+    void evaluate( const double* tCoordinates,
+                   size_t numberOfSamples,
+                   double* curveX,
+                   double* curveY ) const;
+
+    //! Same as stream2DCurve with the control points and knot vector of this curve.
+    void stream( double tBegin,
+                 double tEnd,
+                 size_t numberOfSamples,
+                 const CurveSink& sink,
+                 size_t blockSize = defaultStreamBlockSize ) const;
+
+    void stream( const ParameterSource& source,
+                 const CurveSink& sink,
+                 size_t blockSize = defaultStreamBlockSize ) const;
+
+private:
+    KnotVector m_knotVector;
+
+    std::vector<double> m_xCoordinates;
+    std::vector<double> m_yCoordinates;
+};
+
+} // namespace splinekernel
+} // namespace cie
+
+#endif // CIE_BSPLINECURVE_HPP
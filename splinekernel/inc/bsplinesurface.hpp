@@ -0,0 +1,79 @@
+#ifndef CIE_BSPLINESURFACE_HPP
+#define CIE_BSPLINESURFACE_HPP
+
+#include <array>
+#include <vector>
+#include "stddef.h"
+
+#include "surface.hpp"
+
+namespace cie
+{
+namespace splinekernel
+{
+
+/*! A B-Spline surface owning its control points and the knot vectors in r and s direction. As
+ *  for BSplineCurve, sizes and knot vectors are validated once and the derived data is cached.
+ *  The control points are given as one matrix per component, see evaluateSurface.
+ */
+class BSplineSurface
+{
+public:
+    BSplineSurface( const std::array<std::vector<double>, 2>& knotVectors,
+                    const VectorOfMatrices& controlPoints );
+
+    BSplineSurface( const std::array<KnotVector, 2>& knotVectors,
+                    const VectorOfMatrices& controlPoints );
+
+    size_t numberOfComponents( ) const;
+    std::array<size_t, 2> numberOfControlPoints( ) const;
+    std::array<size_t, 2> polynomialDegrees( ) const;
+
+    const std::array<KnotVector, 2>& knotVectors( ) const;
+    const VectorOfMatrices& controlPoints( ) const;
+
+    //! Evaluation plans for the tensor product of the given coordinates in r and s direction.
+    std::array<EvaluationPlan, 2> createPlans( const std::vector<double>& rCoordinates,
+                                               const std::vector<double>& sCoordinates,
+                                               size_t numberOfDerivatives = 0 ) const;
+
+    //! Evaluates the surface on a grid of equidistant samples spanning the parameter ranges.
+    VectorOfMatrices evaluate( std::array<size_t, 2> numberOfSamplePoints ) const;
+
+    //! Evaluates the surface on the tensor product of the given coordinates.
+    VectorOfMatrices evaluate( const std::vector<double>& rCoordinates,
+                               const std::vector<double>& sCoordinates ) const;
+
+    //! Evaluates the surface with evaluation plans created for its knot vectors.
+    VectorOfMatrices evaluate( const std::array<EvaluationPlan, 2>& plans ) const;
+
+    //! Same as evaluate, but also computing the partial derivatives and normals, see evaluateSurfaceDerivatives.
+    SurfaceDerivatives evaluateDerivatives( std::array<size_t, 2> numberOfSamplePoints ) const;
+
+    SurfaceDerivatives evaluateDerivatives( const std::vector<double>& rCoordinates,
+                                            const std::vector<double>& sCoordinates ) const;
+
+    SurfaceDerivatives evaluateDerivatives( const std::array<EvaluationPlan, 2>& plans ) const;
+
+    //! Same as evaluateSurfaceAtPoints with the knot vectors and control points of this surface.
+    std::vector<std::vector<double>> evaluateAtPoints( const std::vector<double>& rCoordinates,
+                                                       const std::vector<double>& sCoordinates ) const;
+
+    /*! Same as above, but reading numberOfPoints coordinates from existing arrays and writing the
+     *  values of component i to results[i].
+     */
+    void evaluateAtPoints( const double* rCoordinates,
+                           const double* sCoordinates,
+                           size_t numberOfPoints,
+                           const std::vector<double*>& results ) const;
+
+private:
+    std::array<KnotVector, 2> m_knotVectors;
+
+    VectorOfMatrices m_controlPoints;
+};
+
+} // namespace splinekernel
+} // namespace cie
+
+#endif // CIE_BSPLINESURFACE_HPP
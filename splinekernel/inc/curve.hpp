@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <array>
+#include <functional>
+#include "stddef.h"
 
 namespace cie
 {
@@ -27,6 +29,67 @@ std::array<std::vector<double>, 2> evaluate2DCurveDeBoor( const std::vector<doub
                                                           const std::vector<double>& yCoordinates,
                                                           const std::vector<double>& knotVector );
 
+/*! Same as evaluate2DCurve, but reading the parametric coordinates from and writing the curve
+ *  coordinates to existing arrays of numberOfSamples values each. This allows evaluating into
+ *  buffers owned by the caller (e.g. numpy arrays) without copying.
+ */
+void evaluate2DCurve( const double* tCoordinates,
+                      size_t numberOfSamples,
+                      const std::vector<double>& xCoordinates,
+                      const std::vector<double>& yCoordinates,
+                      const std::vector<double>& knotVector,
+                      double* curveX,
+                      double* curveY );
+
+//! Same as above, but using De Boor's algorithm.
+void evaluate2DCurveDeBoor( const double* tCoordinates,
+                            size_t numberOfSamples,
+                            const std::vector<double>& xCoordinates,
+                            const std::vector<double>& yCoordinates,
+                            const std::vector<double>& knotVector,
+                            double* curveX,
+                            double* curveY );
+
+/*! Receives one block of samples evaluated by stream2DCurve: the index of the first sample in the
+ *  block, the number of samples in the block and their parametric and curve coordinates. The
+ *  buffers are reused for the next block, so the sink must consume or copy the values.
+ */
+using CurveSink = std::function<void( size_t firstSample,
+                                      size_t numberOfSamples,
+                                      const double* tCoordinates,
+                                      const double* curveX,
+                                      const double* curveY )>;
+
+/*! Provides the parametric coordinates for stream2DCurve block by block. Writes at most capacity
+ *  coordinates to the given buffer and returns their number, zero once there are no more.
+ */
+using ParameterSource = std::function<size_t( double* tCoordinates, size_t capacity )>;
+
+//! Default number of samples per block in stream2DCurve
+const size_t defaultStreamBlockSize = 65536;
+
+/*! Evaluates the curve at numberOfSamples equidistant parametric coordinates from tBegin to tEnd
+ *  and passes them to sink in blocks of at most blockSize samples, in order and on the calling
+ *  thread. Only one block is stored at a time, such that the memory usage does not depend on the
+ *  number of samples. Each block is evaluated in parallel as in evaluate2DCurve.
+ */
+void stream2DCurve( double tBegin,
+                    double tEnd,
+                    size_t numberOfSamples,
+                    const std::vector<double>& xCoordinates,
+                    const std::vector<double>& yCoordinates,
+                    const std::vector<double>& knotVector,
+                    const CurveSink& sink,
+                    size_t blockSize = defaultStreamBlockSize );
+
+//! Same as above for the parametric coordinates provided by source, e.g. read from a file.
+void stream2DCurve( const ParameterSource& source,
+                    const std::vector<double>& xCoordinates,
+                    const std::vector<double>& yCoordinates,
+                    const std::vector<double>& knotVector,
+                    const CurveSink& sink,
+                    size_t blockSize = defaultStreamBlockSize );
+
 /*! De Boor's algorithm for evaluating (x, y) at one parametric coordinate t. The parameter
  *  recursionLevel has a default value of 1, which will be used if no argument is passed. */
 std::array<double, 2> deBoor( double t,
@@ -45,11 +108,77 @@ std::array<double, 2> deBoorOptimized( double t,
                                        const std::vector<double>& xCoordinates,
                                        const std::vector<double>& yCoordinates );
 
+//! Same as above but using the given workspace of size 2 * ( p + 1 ) instead of allocating.
+std::array<double, 2> deBoorOptimized( double t,
+                                       size_t i,
+                                       size_t p,
+                                       const std::vector<double>& knotVector,
+                                       const std::vector<double>& xCoordinates,
+                                       const std::vector<double>& yCoordinates,
+                                       double* workspace );
+
 //! Determines the knot span of the parametric coordinate t.
 size_t findKnotSpan( double t,
                      size_t numberOfControlPoints,
                      const std::vector<double>& knotVector );
 
+/*! Determines the knot spans of a sequence of parametric coordinates. The search for each
+ *  coordinate starts at the span found for the previous one and proceeds by exponential search,
+ *  so walking through sorted coordinates costs amortized O(1) per coordinate. Moving backwards
+ *  falls back to a binary search. The knot vector must outlive the cursor.
+ */
+class KnotSpanCursor
+{
+public:
+    KnotSpanCursor( size_t numberOfControlPoints,
+                    const std::vector<double>& knotVector );
+
+    //! Returns the same span as findKnotSpan( t, numberOfControlPoints, knotVector ).
+    size_t find( double t );
+
+private:
+    const std::vector<double>& m_knotVector;
+    size_t m_numberOfControlPoints;
+    size_t m_knotSpanIndex;
+};
+
+class UniformKnotVector;
+
+namespace detail
+{
+
+//! Same as findKnotSpan, but without instrumentation for use in per sample loops.
+size_t searchKnotSpan( double t,
+                       size_t numberOfControlPoints,
+                       const std::vector<double>& knotVector );
+
+/*! Blocked and parallel evaluation shared by evaluate2DCurve, evaluate2DCurveDeBoor and
+ *  BSplineCurve. Sizes are not checked and uniform must have been set up for knotVector.
+ */
+void evaluateCurveInBlocks( const double* tCoordinates,
+                            size_t numberOfSamples,
+                            const std::vector<double>& xCoordinates,
+                            const std::vector<double>& yCoordinates,
+                            const std::vector<double>& knotVector,
+                            const UniformKnotVector& uniform,
+                            double* curveX,
+                            double* curveY,
+                            bool useDeBoor );
+
+//! Source for numberOfSamples equidistant parametric coordinates from tBegin to tEnd.
+ParameterSource equidistantParameterSource( double tBegin, double tEnd, size_t numberOfSamples );
+
+//! Streaming loop shared by stream2DCurve and BSplineCurve::stream, with the same requirements as above.
+void streamCurve( const ParameterSource& source,
+                  const std::vector<double>& xCoordinates,
+                  const std::vector<double>& yCoordinates,
+                  const std::vector<double>& knotVector,
+                  const UniformKnotVector& uniform,
+                  const CurveSink& sink,
+                  size_t blockSize );
+
+} // namespace detail
+
 } // namespace splinekernel
 } // namespace cie
 
@@ -0,0 +1,80 @@
+#ifndef CIE_EVALUATIONPLAN_HPP
+#define CIE_EVALUATIONPLAN_HPP
+
+#include <vector>
+#include <array>
+#include "stddef.h"
+
+namespace cie
+{
+namespace splinekernel
+{
+
+class KnotVector;
+class UniformKnotVector;
+
+/*! Caches the knot spans and the nonzero basis function values of a knot vector at a fixed set of
+ *  parametric coordinates. Evaluating a spline with new control points then reduces to a sparse
+ *  matrix-vector product with p + 1 entries per sample. Optionally the derivatives of the basis
+ *  functions are cached as well, e.g. for evaluateSurfaceDerivatives.
+ */
+class EvaluationPlan
+{
+public:
+    /*! Evaluates and stores the basis functions at the given coordinates.
+     *  @param tCoordinates The parametric coordinates at which splines shall be evaluated
+     *  @param numberOfControlPoints The number of basis functions / control points
+     *  @param knotVector
+     *  @param numberOfDerivatives The highest derivative of the basis functions to store as well
+     */
+    EvaluationPlan( const std::vector<double>& tCoordinates,
+                    size_t numberOfControlPoints,
+                    const std::vector<double>& knotVector,
+                    size_t numberOfDerivatives = 0 );
+
+    //! Same as above, using the data cached in a knot vector that has already been validated.
+    EvaluationPlan( const std::vector<double>& tCoordinates,
+                    const KnotVector& knotVector,
+                    size_t numberOfDerivatives = 0 );
+
+    size_t numberOfSamples( ) const;
+    size_t numberOfControlPoints( ) const;
+    size_t polynomialDegree( ) const;
+    size_t numberOfDerivatives( ) const;
+
+    //! Index of the first of the p + 1 control points contributing to the given sample
+    size_t firstControlPoint( size_t iSample ) const;
+
+    //! The p + 1 nonzero basis function values at the given sample
+    const double* basisValues( size_t iSample ) const;
+
+    //! The k-th derivatives of the p + 1 nonzero basis functions, k <= numberOfDerivatives( )
+    const double* basisDerivatives( size_t iSample, size_t k ) const;
+
+    //! Evaluates one component (e.g. x-values) of the spline with the given control point values.
+    std::vector<double> evaluate( const std::vector<double>& controlPointValues ) const;
+
+    //! Evaluates a 2D curve with the given control point coordinates, similar to evaluate2DCurve.
+    std::array<std::vector<double>, 2> evaluate( const std::vector<double>& xCoordinates,
+                                                 const std::vector<double>& yCoordinates ) const;
+
+private:
+    void evaluateBasis( const std::vector<double>& tCoordinates,
+                        const std::vector<double>& knotVector,
+                        const UniformKnotVector& uniform );
+
+    size_t m_numberOfControlPoints;
+    size_t m_polynomialDegree;
+    size_t m_numberOfDerivatives;
+
+    std::vector<size_t> m_firstControlPoints;
+    std::vector<double> m_basisValues;
+
+    // Derivatives 1 to m_numberOfDerivatives, one block of m_numberOfDerivatives x ( p + 1 ) per sample
+    std::vector<double> m_derivativeValues;
+};
+
+} // namespace splinekernel
+} // namespace cie
+
+#endif // CIE_EVALUATIONPLAN_HPP
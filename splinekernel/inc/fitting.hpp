@@ -0,0 +1,141 @@
+#ifndef CIE_FITTING_HPP
+#define CIE_FITTING_HPP
+
+#include <array>
+#include <utility>
+#include <vector>
+#include "stddef.h"
+
+#include "bandedmatrix.hpp"
+#include "evaluationplan.hpp"
+#include "interpolation.hpp"
+#include "knotvector.hpp"
+#include "surface.hpp"
+
+namespace cie
+{
+namespace splinekernel
+{
+
+/*! Maps values at a fixed set of parameter positions to the control points of the B-Spline that
+ *  interpolates them or, with fewer control points than positions, approximates them in the
+ *  (weighted) least squares sense. The banded collocation matrix, or the normal equations with
+ *  bandwidth p, are assembled and factorized once on construction, such that fitting many sets of
+ *  values, e.g. all rows of a surface grid, only requires a forward and backward substitution for
+ *  each of them.
+ */
+class BSplineFit
+{
+public:
+    /*! @param parameterPositions Sorted positions of the values within the knot vector bounds
+     *  @param knotVector With at most as many control points as parameter positions. The positions
+     *                    must be distributed such that the system is regular, i.e. the
+     *                    Schoenberg-Whitney conditions hold.
+     *  @param weights Optional non-negative weight of each position in the least squares sum. Not
+     *                 used for interpolation, which is exact for any weights.
+     */
+    BSplineFit( const std::vector<double>& parameterPositions,
+                const KnotVector& knotVector,
+                const std::vector<double>& weights = { } );
+
+    size_t numberOfPoints( ) const;
+    size_t numberOfControlPoints( ) const;
+
+    const KnotVector& knotVector( ) const;
+
+    //! Whether the number of control points equals the number of points
+    bool interpolates( ) const;
+
+    /*! Computes the control points for multiple sets of values at once.
+     *  @param values Row-major numberOfPoints x numberOfRightHandSides block, such that the values
+     *                of one parameter position are contiguous
+     *  @param controlPoints Target numberOfControlPoints x numberOfRightHandSides block
+     */
+    void fit( const double* values, size_t numberOfRightHandSides, double* controlPoints ) const;
+
+    //! Computes the control points for one set of values.
+    std::vector<double> fit( const std::vector<double>& values ) const;
+
+private:
+    KnotVector m_knotVector;
+    EvaluationPlan m_plan;
+    BandedMatrix m_matrix;
+
+    // Empty for unit weights
+    std::vector<double> m_weights;
+};
+
+/*! Computes a knot vector for fitting values at the given parameter positions with the given number
+ *  of control points. For interpolation the inner knots are averages of the parameter positions as
+ *  in knotVectorUsingAveraging, otherwise they are placed such that every knot span contains
+ *  parameter positions (The NURBS Book, eq. 9.68 and 9.69). The end knots are repeated p + 1 times
+ *  at the first and the last parameter position.
+ */
+std::vector<double> knotVectorForFitting( const std::vector<double>& parameterPositions,
+                                          size_t polynomialDegree,
+                                          size_t numberOfControlPoints );
+
+/*! Returns the control points and knot vector of the curve with the given degree and number of
+ *  control points that approximates the given points in the least squares sense, using
+ *  centripetal parameter positions and knotVectorForFitting. With as many control points as
+ *  points, this is the same as interpolateWithBSplineCurveND. The normal equations are assembled
+ *  from the p + 1 nonzero basis functions per point and solved for all components at once, such
+ *  that the cost is linear in the number of points.
+ *  @param interpolationPoints One vector of values per component
+ *  @param polynomialDegree
+ *  @param numberOfControlPoints Between p + 1 and the number of points
+ *  @param weights Optional non-negative weight per point, e.g. to pin the end points with large weights
+ *  @param numberOfGeometricComponents See interpolateWithBSplineCurveND
+ */
+ControlPointsNDAndKnotVector approximateWithBSplineCurveND( const ControlPointsND& interpolationPoints,
+                                                            size_t polynomialDegree,
+                                                            size_t numberOfControlPoints,
+                                                            const std::vector<double>& weights = { },
+                                                            size_t numberOfGeometricComponents = 0 );
+
+//! Same as approximateWithBSplineCurveND for 2D points.
+ControlPointsAndKnotVector approximateWithBSplineCurve( const ControlPoints2D& interpolationPoints,
+                                                        size_t polynomialDegree,
+                                                        size_t numberOfControlPoints,
+                                                        const std::vector<double>& weights = { } );
+
+//! Control points of a surface, as used by evaluateSurface, together with the knot vectors in r and s.
+using SurfaceControlPointsAndKnotVectors = std::pair<VectorOfMatrices, std::array<std::vector<double>, 2>>;
+
+/*! Computes the control points of the surface fitting gridded values with a tensor product of the
+ *  given one-dimensional fits. As the tensor product system separates, it is solved with banded
+ *  solves in r-direction for all columns of the grid and in s-direction for all rows of the result.
+ *  @param fits The fits in r- and s-direction
+ *  @param gridPoints One matrix of fits[0].numberOfPoints( ) x fits[1].numberOfPoints( ) values per component
+ */
+VectorOfMatrices fitBSplineSurface( const std::array<BSplineFit, 2>& fits,
+                                    const VectorOfMatrices& gridPoints );
+
+/*! Returns the control points and knot vectors of the surface with given degrees interpolating the
+ *  gridded values at the given parameter positions in r- and s-direction.
+ */
+SurfaceControlPointsAndKnotVectors interpolateWithBSplineSurface( const std::array<std::vector<double>, 2>& parameterPositions,
+                                                                  const VectorOfMatrices& gridPoints,
+                                                                  std::array<size_t, 2> polynomialDegrees );
+
+//! Same as above with equidistant parameter positions in [0, 1], e.g. for height fields on regular grids.
+SurfaceControlPointsAndKnotVectors interpolateWithBSplineSurface( const VectorOfMatrices& gridPoints,
+                                                                  std::array<size_t, 2> polynomialDegrees );
+
+/*! Same as interpolateWithBSplineSurface, but approximating the gridded values in the least squares
+ *  sense with the given number of control points in r- and s-direction.
+ */
+SurfaceControlPointsAndKnotVectors approximateWithBSplineSurface( const std::array<std::vector<double>, 2>& parameterPositions,
+                                                                  const VectorOfMatrices& gridPoints,
+                                                                  std::array<size_t, 2> polynomialDegrees,
+                                                                  std::array<size_t, 2> numberOfControlPoints );
+
+//! Same as above with equidistant parameter positions in [0, 1].
+SurfaceControlPointsAndKnotVectors approximateWithBSplineSurface( const VectorOfMatrices& gridPoints,
+                                                                  std::array<size_t, 2> polynomialDegrees,
+                                                                  std::array<size_t, 2> numberOfControlPoints );
+
+} // namespace splinekernel
+} // namespace cie
+
+#endif // CIE_FITTING_HPP
@@ -0,0 +1,79 @@
+#ifndef CIE_INCREMENTALINTERPOLATION_HPP
+#define CIE_INCREMENTALINTERPOLATION_HPP
+
+#include "interpolation.hpp"
+#include "bandedmatrix.hpp"
+
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+/*! Interpolates a growing sequence of points, e.g. while a curve is drawn interactively. Gives the
+ *  same result as interpolateWithBSplineCurveND for all points appended so far.
+ *
+ *  The parameter positions are kept as unnormalized centripetal lengths. Since B-Splines are
+ *  invariant under scaling of the knot vector, appending a point then only changes the last few
+ *  knots and rows of the collocation matrix and append only refactorizes these (O(p^3)). The
+ *  substitution and returning the knot vector scaled back to [0, 1] are O(n * p) and only done
+ *  in interpolate and preview.
+ */
+class IncrementalInterpolator
+{
+public:
+    /*! @param polynomialDegree
+     *  @param numberOfComponents The number of values per point, e.g. 2 for x and y
+     *  @param numberOfGeometricComponents The number of leading components that determine the
+     *                                     parameter positions, zero uses all components.
+     */
+    IncrementalInterpolator( size_t polynomialDegree,
+                             size_t numberOfComponents,
+                             size_t numberOfGeometricComponents = 0 );
+
+    size_t polynomialDegree( ) const;
+    size_t numberOfComponents( ) const;
+    size_t numberOfPoints( ) const;
+
+    //! Appends a point with one value per component. Leaves the interpolator unchanged if this throws.
+    void append( const std::vector<double>& point );
+
+    //! Interpolates all points appended so far (requires at least p + 1 points).
+    ControlPointsNDAndKnotVector interpolate( );
+
+    //! Interpolates all points appended so far and a tentative last point, without appending it.
+    ControlPointsNDAndKnotVector preview( const std::vector<double>& point );
+
+private:
+    void push( const std::vector<double>& point );
+    void pop( );
+
+    // Updates the knot vector and refactorizes the rows that are not final for all points
+    void factorize( );
+
+    // Substitution for the current factorization, which must include all points
+    ControlPointsNDAndKnotVector solve( ) const;
+
+    size_t m_polynomialDegree;
+    size_t m_numberOfGeometricComponents;
+
+    ControlPointsND m_points;
+    std::vector<double> m_lengths;
+
+    // Unnormalized knot vector, collocation matrix and knot spans of the rows
+    std::vector<double> m_knotVector;
+    BandedMatrix m_matrix;
+    std::vector<size_t> m_knotSpans;
+
+    // Leading rows of m_matrix that are factorized and the same for all extensions of the appended points
+    size_t m_numberOfFinalRows;
+
+    // Number of points of the current factorization, zero if there is none
+    size_t m_numberOfFactorizedPoints;
+};
+
+} // namespace splinekernel
+} // namespace cie
+
+#endif // CIE_INCREMENTALINTERPOLATION_HPP
@@ -0,0 +1,97 @@
+#ifndef CIE_INSTRUMENTATION_HPP
+#define CIE_INSTRUMENTATION_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "stddef.h"
+
+namespace cie
+{
+namespace splinekernel
+{
+
+//! Accumulated measurements of one instrumented function or stage.
+struct InstrumentationRecord
+{
+    std::string name;
+    size_t numberOfCalls;
+    size_t numberOfSamples;
+    double seconds;
+};
+
+//! True if the library was compiled with SPLINEKERNEL_ENABLE_INSTRUMENTATION.
+bool instrumentationEnabled( );
+
+//! The measurements recorded since the start or the last reset, sorted by name.
+std::vector<InstrumentationRecord> instrumentationReport( );
+
+//! Sets all measurements to zero.
+void resetInstrumentation( );
+
+namespace detail
+{
+
+struct InstrumentationCounter
+{
+    std::atomic<size_t> numberOfCalls { 0 };
+    std::atomic<size_t> numberOfSamples { 0 };
+    std::atomic<long long> nanoseconds { 0 };
+};
+
+//! Returns the counter with the given name, all sites using the same name share it.
+InstrumentationCounter& instrumentationCounter( const std::string& name );
+
+//! Adds the time from construction to destruction to the counter.
+class ScopedTimer
+{
+public:
+    ScopedTimer( InstrumentationCounter& counter, size_t numberOfSamples ) :
+        m_counter( counter ), m_start( std::chrono::steady_clock::now( ) )
+    {
+        m_counter.numberOfCalls += 1;
+        m_counter.numberOfSamples += numberOfSamples;
+    }
+
+    ~ScopedTimer( )
+    {
+        auto duration = std::chrono::steady_clock::now( ) - m_start;
+
+        m_counter.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>( duration ).count( );
+    }
+
+    ScopedTimer( const ScopedTimer& ) = delete;
+    ScopedTimer& operator=( const ScopedTimer& ) = delete;
+
+private:
+    InstrumentationCounter& m_counter;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace detail
+} // namespace splinekernel
+} // namespace cie
+
+/*! Measures the remainder of the enclosing scope under the given name and adds numberOfSamples to
+ *  its sample count. Expands to nothing unless SPLINEKERNEL_ENABLE_INSTRUMENTATION is defined.
+ */
+#ifdef SPLINEKERNEL_ENABLE_INSTRUMENTATION
+
+#define SPLINEKERNEL_CONCATENATE_IMPL( a, b ) a##b
+#define SPLINEKERNEL_CONCATENATE( a, b ) SPLINEKERNEL_CONCATENATE_IMPL( a, b )
+
+#define SPLINEKERNEL_TIME_SCOPE( name, numberOfSamples )                                              \
+    static ::cie::splinekernel::detail::InstrumentationCounter&                                       \
+        SPLINEKERNEL_CONCATENATE( instrumentationCounter, __LINE__ ) =                                \
+            ::cie::splinekernel::detail::instrumentationCounter( name );                              \
+    ::cie::splinekernel::detail::ScopedTimer SPLINEKERNEL_CONCATENATE( instrumentationTimer, __LINE__ )( \
+        SPLINEKERNEL_CONCATENATE( instrumentationCounter, __LINE__ ), numberOfSamples )
+
+#else
+
+#define SPLINEKERNEL_TIME_SCOPE( name, numberOfSamples )
+
+#endif
+
+#endif // CIE_INSTRUMENTATION_HPP
@@ -3,6 +3,8 @@
 
 #include <array>
 #include <vector>
+#include <utility>
+#include "stddef.h"
 
 namespace cie
 {
@@ -12,13 +14,34 @@ namespace splinekernel
 using ControlPoints2D = std::array<std::vector<double>, 2>;
 using ControlPointsAndKnotVector = std::pair<ControlPoints2D, std::vector<double>>;
 
-//! Returns the control points for a b-spline curve with given degree that interpolates the given points.
+//! Points with an arbitrary number of components, e.g. x, y and z coordinates plus scalar channels
+using ControlPointsND = std::vector<std::vector<double>>;
+using ControlPointsNDAndKnotVector = std::pair<ControlPointsND, std::vector<double>>;
+
+/*! Returns the control points for a b-spline curve with given degree that interpolates the given
+ *  points. The banded collocation matrix is factorized once and used for all coordinates. */
 ControlPointsAndKnotVector interpolateWithBSplineCurve( const ControlPoints2D& interpolationPoints,
                                                         size_t polynomialDegree );
 
+/*! Same as interpolateWithBSplineCurve for points with any number of components. The collocation
+ *  matrix is factorized once and all components are solved together as a block of right hand sides.
+ *  @param interpolationPoints One vector of values per component
+ *  @param polynomialDegree
+ *  @param numberOfGeometricComponents The number of leading components used to compute the
+ *                                     parameter positions, such that attached scalar channels do
+ *                                     not influence the parameterization. Zero uses all components.
+ */
+ControlPointsNDAndKnotVector interpolateWithBSplineCurveND( const ControlPointsND& interpolationPoints,
+                                                            size_t polynomialDegree,
+                                                            size_t numberOfGeometricComponents = 0 );
+
 //! Computes the parameter positions for the given global interpolation points
 std::vector<double> centripetalParameterPositions( const ControlPoints2D& interpolationPoints );
 
+//! Same as above for points with any number of components, of which the first numberOfGeometricComponents are used (all if zero)
+std::vector<double> centripetalParameterPositionsND( const ControlPointsND& interpolationPoints,
+                                                     size_t numberOfGeometricComponents = 0 );
+
 //! Computes the knot vector for the given parameter positions using the averaging technique
 std::vector<double> knotVectorUsingAveraging( const std::vector<double>& parameterPositions,
                                               size_t polynomialDegree );
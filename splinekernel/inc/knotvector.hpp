@@ -0,0 +1,78 @@
+#ifndef CIE_KNOTVECTOR_HPP
+#define CIE_KNOTVECTOR_HPP
+
+#include <memory>
+#include <vector>
+#include "stddef.h"
+
+#include "uniformknotvector.hpp"
+
+namespace cie
+{
+namespace splinekernel
+{
+
+/*! A knot vector that has been validated for a number of control points, together with data
+ *  derived from it once instead of in every evaluation:
+ *  - The polynomial degree p = m - n - 1 for m knots and n control points.
+ *  - The breakpoints, i.e. the distinct knot values, and their multiplicities.
+ *  - The indices of the nonzero knot spans in [t_p, t_n].
+ *  - The uniform knot vector fast paths, see UniformKnotVector.
+ *  The data is immutable and shared between copies, so copying is cheap.
+ */
+class KnotVector
+{
+public:
+    /*! Throws if the knot vector is not sorted, too short for the number of control points,
+     *  has no nonzero span in [t_p, t_n] or contains a knot more than p + 1 times.
+     */
+    KnotVector( size_t numberOfControlPoints,
+                const std::vector<double>& knots );
+
+    size_t numberOfControlPoints( ) const;
+    size_t polynomialDegree( ) const;
+
+    const std::vector<double>& knots( ) const;
+
+    //! The distinct knot values in increasing order
+    const std::vector<double>& breakpoints( ) const;
+
+    //! How often each of the breakpoints appears in the knot vector
+    const std::vector<size_t>& multiplicities( ) const;
+
+    //! The indices s of the knot spans [t_s, t_s+1) in [t_p, t_n] with nonzero length
+    const std::vector<size_t>& nonzeroKnotSpans( ) const;
+
+    //! The parameter range [t_p, t_n] in which the spline is defined
+    double lowerBound( ) const;
+    double upperBound( ) const;
+
+    //! Returns the same span as findKnotSpan( t, numberOfControlPoints, knots ).
+    size_t findKnotSpan( double t ) const;
+
+    const UniformKnotVector& uniform( ) const;
+
+private:
+    struct Data
+    {
+        Data( size_t numberOfControlPoints, const std::vector<double>& knots );
+
+        std::vector<double> knots;
+        size_t numberOfControlPoints;
+        size_t polynomialDegree;
+
+        std::vector<double> breakpoints;
+        std::vector<size_t> multiplicities;
+        std::vector<size_t> nonzeroKnotSpans;
+
+        // Refers to knots above, so the members must not be reordered
+        UniformKnotVector uniform;
+    };
+
+    std::shared_ptr<const Data> m_data;
+};
+
+} // namespace splinekernel
+} // namespace cie
+
+#endif // CIE_KNOTVECTOR_HPP
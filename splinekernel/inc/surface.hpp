@@ -6,6 +6,8 @@
 #include <algorithm>
 
 #include "linalg.hpp"
+#include "evaluationplan.hpp"
+#include "knotvector.hpp"
 
 namespace cie
 {
@@ -32,6 +34,74 @@ VectorOfMatrices evaluateSurface( const std::array<std::vector<double>, 2>& knot
                                   const VectorOfMatrices& controlPoints,
                                   std::array<size_t, 2> numberOfSamplePoints );
 
+/* Same as above, but with the basis functions in r and s direction cached in evaluation plans.
+ * Repeatedly evaluating surfaces with the same knot vectors and sample points this way only
+ * multiplies the nonzero basis functions with the control point values. The tensor product is
+ * sum-factorized: the control points are first contracted with the p + 1 nonzero basis functions
+ * in r-direction and the result then with the q + 1 nonzero basis functions in s-direction.
+ * @param plans Evaluation plans in r and s directions
+ * @param controlPoints Control point components, each matching the sizes of the plans
+ * @return One matrix per component with the number of samples of the plans as dimensions
+ */
+VectorOfMatrices evaluateSurface( const std::array<EvaluationPlan, 2>& plans,
+                                  const VectorOfMatrices& controlPoints );
+
+//! Surface values, first partial derivatives and normals computed by evaluateSurfaceDerivatives.
+struct SurfaceDerivatives
+{
+    //! Same as returned from evaluateSurface
+    VectorOfMatrices values;
+
+    //! The partial derivatives dS/dr and dS/ds of each component
+    VectorOfMatrices derivativesR;
+    VectorOfMatrices derivativesS;
+
+    /*! For surfaces with three components the x, y and z components of the unit normal
+     *  dS/dr x dS/ds / | dS/dr x dS/ds |, zero where the surface is degenerate. Empty otherwise.
+     */
+    VectorOfMatrices normals;
+};
+
+/* Same as evaluateSurface, but computing the first partial derivatives and for 3D surfaces the
+ * unit normals in the same sweep over the samples, reusing the contraction in r-direction.
+ */
+SurfaceDerivatives evaluateSurfaceDerivatives( const std::array<std::vector<double>, 2>& knotVectors,
+                                               const VectorOfMatrices& controlPoints,
+                                               std::array<size_t, 2> numberOfSamplePoints );
+
+//! Same as above using evaluation plans, which must have been created with first derivatives.
+SurfaceDerivatives evaluateSurfaceDerivatives( const std::array<EvaluationPlan, 2>& plans,
+                                               const VectorOfMatrices& controlPoints );
+
+/* Evaluates a 2D B-Spline patch at scattered parameter pairs ( rCoordinates[i], sCoordinates[i] )
+ * instead of a grid. The points are grouped by the knot span cell they fall into, so the
+ * ( p + 1 ) x ( q + 1 ) control points of a cell are loaded once for all of its points. The points
+ * may be given in any order.
+ * @param knotVectors Two knot vectors in r and s directions
+ * @param controlPoints Control point components as for evaluateSurface
+ * @param rCoordinates, sCoordinates The parametric coordinates of the points
+ * @return One vector per component with one value per point
+ */
+std::vector<std::vector<double>> evaluateSurfaceAtPoints( const std::array<std::vector<double>, 2>& knotVectors,
+                                                          const VectorOfMatrices& controlPoints,
+                                                          const std::vector<double>& rCoordinates,
+                                                          const std::vector<double>& sCoordinates );
+
+namespace detail
+{
+
+/* Implementation of evaluateSurfaceAtPoints without size checks, shared with BSplineSurface. Writes
+ * the values of component i to results[i], which must hold numberOfPoints values.
+ */
+void evaluateSurfaceAtPoints( const std::array<KnotVector, 2>& knotVectors,
+                              const VectorOfMatrices& controlPoints,
+                              const double* rCoordinates,
+                              const double* sCoordinates,
+                              size_t numberOfPoints,
+                              const std::vector<double*>& results );
+
+} // namespace detail
+
 } // namespace splinekernel
 } // namespace cie
 
@@ -0,0 +1,105 @@
+#ifndef CIE_THREADPOOL_HPP
+#define CIE_THREADPOOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "stddef.h"
+
+namespace cie
+{
+namespace splinekernel
+{
+
+/*! Worker threads executing queued tasks and parallel loops. Parallel loops split their index
+ *  range into chunks that the calling thread and the workers claim one after another until all
+ *  are done, which balances the load when chunks take different amounts of time.
+ */
+class ThreadPool
+{
+public:
+    //! Creates a pool running loops on numberOfThreads threads, the calling thread included.
+    explicit ThreadPool( size_t numberOfThreads );
+
+    ~ThreadPool( );
+
+    ThreadPool( const ThreadPool& ) = delete;
+    ThreadPool& operator=( const ThreadPool& ) = delete;
+
+    //! The number of threads, including the thread calling parallelFor.
+    size_t numberOfThreads( ) const;
+
+    //! Adds workers such that the pool has at least the given number of threads.
+    void reserve( size_t numberOfThreads );
+
+    //! Runs the task on one of the worker threads.
+    void enqueue( std::function<void( )> task );
+
+    /*! Calls function( chunkBegin, chunkEnd ) for disjoint chunks that together cover [begin, end)
+     *  and blocks until all chunks are done. Chunks hold at least grainSize indices, unless the
+     *  range is smaller. Rethrows the first exception thrown by function.
+     *  @param numberOfThreads The maximum number of threads working on the loop, the calling
+     *                         thread included. Zero uses all threads of the pool.
+     */
+    void parallelFor( size_t begin,
+                      size_t end,
+                      size_t grainSize,
+                      const std::function<void( size_t, size_t )>& function,
+                      size_t numberOfThreads = 0 );
+
+private:
+    void work( );
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void( )>> m_tasks;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    bool m_stop;
+};
+
+//! The thread pool of the library, created on first use with getNumberOfThreads( ) threads.
+ThreadPool& globalThreadPool( );
+
+//! Sets the number of threads used by the evaluation functions. Zero uses all hardware threads.
+void setNumberOfThreads( size_t numberOfThreads );
+
+//! The number of threads used by the evaluation functions.
+size_t getNumberOfThreads( );
+
+//! Runs ThreadPool::parallelFor on the global thread pool using getNumberOfThreads( ) threads.
+void parallelFor( size_t begin,
+                  size_t end,
+                  size_t grainSize,
+                  const std::function<void( size_t, size_t )>& function );
+
+/*! Runs function( ) on a worker thread of the global thread pool and returns a future for its
+ *  result (or exception). Parallel loops inside the function use the pool as usual.
+ */
+template<typename Function>
+auto runAsync( Function function ) -> std::future<decltype( function( ) )>
+{
+    using Result = decltype( function( ) );
+
+    auto task = std::make_shared<std::packaged_task<Result( )>>( std::move( function ) );
+    auto future = task->get_future( );
+
+    ThreadPool& pool = globalThreadPool( );
+
+    // A pool for only one thread has no worker that could run the task
+    pool.reserve( 2 );
+    pool.enqueue( [task]( ) { ( *task )( ); } );
+
+    return future;
+}
+
+} // namespace splinekernel
+} // namespace cie
+
+#endif // CIE_THREADPOOL_HPP
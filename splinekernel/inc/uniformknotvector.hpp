@@ -0,0 +1,69 @@
+#ifndef CIE_UNIFORMKNOTVECTOR_HPP
+#define CIE_UNIFORMKNOTVECTOR_HPP
+
+#include <vector>
+#include "stddef.h"
+
+namespace cie
+{
+namespace splinekernel
+{
+
+/*! Detects whether the nonzero knot spans [t_p, t_n] of a knot vector have equal length h (up to a
+ *  relative tolerance) and provides fast paths for this case:
+ *  - The knot span is found in O(1) as p + floor( ( t - t_p ) / h ).
+ *  - In spans whose 2p surrounding knots are all equidistant the p + 1 nonzero basis functions are
+ *    translated copies of the same polynomials in u = ( t - t_s ) / h, which are precomputed once.
+ *    Evaluating them is a small matrix-vector product instead of the Cox-de Boor recurrence.
+ *  Spans near repeated end knots of clamped knot vectors use the general algorithms. The knot
+ *  vector must outlive this object.
+ */
+class UniformKnotVector
+{
+public:
+    UniformKnotVector( size_t numberOfControlPoints,
+                       const std::vector<double>& knotVector,
+                       double tolerance = 1e-10 );
+
+    //! True if all nonzero knot spans have the same length
+    bool isUniform( ) const;
+
+    //! The length of the nonzero knot spans if isUniform( ) is true
+    double knotDistance( ) const;
+
+    size_t polynomialDegree( ) const;
+
+    //! Returns the same span as findKnotSpan( t, numberOfControlPoints, knotVector ).
+    size_t findKnotSpan( double t ) const;
+
+    //! True if the basis functions in the given span are the precomputed uniform polynomials
+    bool hasUniformBasis( size_t knotSpanIndex ) const;
+
+    /*! Coefficients of the uniform basis polynomials, row j holds the p + 1 coefficients of the
+     *  j-th nonzero basis function for increasing powers of u.
+     */
+    const std::vector<double>& basisMatrix( ) const;
+
+    //! Same as evaluateNonzeroBSplineBasis, using the uniform polynomials where possible.
+    void evaluateNonzeroBasis( double t,
+                               size_t knotSpanIndex,
+                               double* basisValues ) const;
+
+private:
+    const std::vector<double>& m_knotVector;
+    size_t m_numberOfControlPoints;
+    size_t m_polynomialDegree;
+
+    double m_knotDistance;
+
+    // Range of knot indices [m_firstUniformKnot, m_lastUniformKnot] with equal distances
+    size_t m_firstUniformKnot;
+    size_t m_lastUniformKnot;
+
+    std::vector<double> m_basisMatrix;
+};
+
+} // namespace splinekernel
+} // namespace cie
+
+#endif // CIE_UNIFORMKNOTVECTOR_HPP
@@ -0,0 +1,162 @@
+#include "bandedmatrix.hpp"
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+BandedMatrix::BandedMatrix( size_t size, size_t lowerBandwidth, size_t upperBandwidth ) :
+    m_size( size ),
+    m_lowerBandwidth( lowerBandwidth ),
+    m_upperBandwidth( upperBandwidth ),
+    m_data( size * ( lowerBandwidth + upperBandwidth + 1 ), 0.0 ),
+    m_factorized( false )
+{ }
+
+size_t BandedMatrix::size( ) const
+{
+    return m_size;
+}
+
+size_t BandedMatrix::lowerBandwidth( ) const
+{
+    return m_lowerBandwidth;
+}
+
+size_t BandedMatrix::upperBandwidth( ) const
+{
+    return m_upperBandwidth;
+}
+
+void BandedMatrix::resize( size_t size )
+{
+    size_t rowSize = m_lowerBandwidth + m_upperBandwidth + 1;
+
+    m_data.resize( size * rowSize, 0.0 );
+
+    m_factorized = m_factorized && size <= m_size;
+    m_size = size;
+}
+
+double BandedMatrix::operator()( size_t i, size_t j ) const
+{
+    return m_data[i * ( m_lowerBandwidth + m_upperBandwidth + 1 ) + m_lowerBandwidth + j - i];
+}
+
+double& BandedMatrix::operator()( size_t i, size_t j )
+{
+    return m_data[i * ( m_lowerBandwidth + m_upperBandwidth + 1 ) + m_lowerBandwidth + j - i];
+}
+
+void BandedMatrix::factorize( size_t firstRow )
+{
+    SPLINEKERNEL_TIME_SCOPE( "BandedMatrix::factorize", m_size - std::min( firstRow, m_size ) );
+
+    double tolerance = 1e-12; // Numerically zero, relative to the largest entry of the row.
+
+    BandedMatrix& A = *this;
+
+    for( size_t i = firstRow; i < m_size; ++i )
+    {
+        double rowScale = 0.0;
+
+        for( size_t j = i - std::min( i, m_lowerBandwidth ); j <= std::min( i + m_upperBandwidth, m_size - 1 ); ++j )
+        {
+            rowScale = std::max( rowScale, std::abs( A( i, j ) ) );
+        }
+
+        // Eliminate the entries left of the diagonal using the already factorized rows above
+        for( size_t k = i - std::min( i, m_lowerBandwidth ); k < i; ++k )
+        {
+            double factor = A( i, k ) / A( k, k );
+
+            A( i, k ) = factor;
+
+            for( size_t j = k + 1; j <= std::min( k + m_upperBandwidth, m_size - 1 ); ++j )
+            {
+                A( i, j ) -= factor * A( k, j );
+            }
+        }
+
+        if( std::abs( A( i, i ) ) <= tolerance * rowScale )
+        {
+            m_factorized = false;
+
+            throw std::runtime_error( "Zero pivot in row " + std::to_string( i ) + " of banded matrix." );
+        }
+    }
+
+    m_factorized = true;
+}
+
+void BandedMatrix::solve( double* rightHandSides, size_t numberOfRightHandSides ) const
+{
+    SPLINEKERNEL_TIME_SCOPE( "BandedMatrix::solve", m_size * numberOfRightHandSides );
+
+    if( !m_factorized )
+    {
+        throw std::runtime_error( "Banded matrix must be factorized before solving." );
+    }
+
+    const BandedMatrix& A = *this;
+
+    // Forward substitution with the unit lower triangle
+    for( size_t i = 0; i < m_size; ++i )
+    {
+        double* b = rightHandSides + i * numberOfRightHandSides;
+
+        for( size_t k = i - std::min( i, m_lowerBandwidth ); k < i; ++k )
+        {
+            const double* x = rightHandSides + k * numberOfRightHandSides;
+
+            for( size_t iRhs = 0; iRhs < numberOfRightHandSides; ++iRhs )
+            {
+                b[iRhs] -= A( i, k ) * x[iRhs];
+            }
+        }
+    }
+
+    // Backward substitution with the upper triangle
+    for( size_t i = m_size; i-- > 0; )
+    {
+        double* b = rightHandSides + i * numberOfRightHandSides;
+
+        for( size_t j = i + 1; j <= std::min( i + m_upperBandwidth, m_size - 1 ); ++j )
+        {
+            const double* x = rightHandSides + j * numberOfRightHandSides;
+
+            for( size_t iRhs = 0; iRhs < numberOfRightHandSides; ++iRhs )
+            {
+                b[iRhs] -= A( i, j ) * x[iRhs];
+            }
+        }
+
+        for( size_t iRhs = 0; iRhs < numberOfRightHandSides; ++iRhs )
+        {
+            b[iRhs] /= A( i, i );
+        }
+    }
+}
+
+std::vector<double> BandedMatrix::solve( const std::vector<double>& rightHandSide ) const
+{
+    if( rightHandSide.size( ) != m_size )
+    {
+        throw std::runtime_error( "Inconsistent size in BandedMatrix::solve." );
+    }
+
+    std::vector<double> solution = rightHandSide;
+
+    solve( solution.data( ), 1 );
+
+    return solution;
+}
+
+} // namespace splinekernel
+} // namespace cie
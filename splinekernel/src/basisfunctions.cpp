@@ -1,8 +1,12 @@
 #include "basisfunctions.hpp"
+#include "curve.hpp"
+#include "instrumentation.hpp"
 
 #include <string>
 #include <cmath>
 #include <stdexcept>
+#include <algorithm>
+#include <utility>
 
 namespace cie
 {
@@ -55,5 +59,206 @@ double evaluateBSplineBasis( double t, size_t i, size_t p, const std::vector<dou
   }
 }
 
+namespace detail
+{
+
+// Degree P fixed at compile time for 1 <= P <= 5 lets the compiler unroll the triangular
+// recurrence completely, P = 0 is the generic version using the runtime degree p.
+template<size_t P>
+void evaluateNonzeroBSplineBasis( double t,
+                                  size_t knotSpanIndex,
+                                  size_t p,
+                                  const std::vector<double>& knotVector,
+                                  double* basisValues )
+{
+  const size_t degree = P == 0 ? p : P;
+
+  // The left and right differences t - t_{i + 1 - j} and t_{i + j} - t are read from the knot
+  // vector directly instead of being cached, so no workspace besides the target is needed.
+  basisValues[0] = 1.0;
+
+  for( size_t j = 1; j <= degree; ++j )
+  {
+    double saved = 0.0;
+
+    for( size_t r = 0; r < j; ++r )
+    {
+      double right = knotVector[knotSpanIndex + r + 1] - t;
+      double left = t - knotVector[knotSpanIndex + r + 1 - j];
+
+      double temp = basisValues[r] / ( right + left );
+
+      basisValues[r] = saved + right * temp;
+      saved = left * temp;
+    }
+
+    basisValues[j] = saved;
+  }
+}
+
+} // namespace detail
+
+void evaluateNonzeroBSplineBasis( double t,
+                                  size_t knotSpanIndex,
+                                  size_t p,
+                                  const std::vector<double>& knotVector,
+                                  double* basisValues )
+{
+  switch( p )
+  {
+    case 1: detail::evaluateNonzeroBSplineBasis<1>( t, knotSpanIndex, p, knotVector, basisValues ); break;
+    case 2: detail::evaluateNonzeroBSplineBasis<2>( t, knotSpanIndex, p, knotVector, basisValues ); break;
+    case 3: detail::evaluateNonzeroBSplineBasis<3>( t, knotSpanIndex, p, knotVector, basisValues ); break;
+    case 4: detail::evaluateNonzeroBSplineBasis<4>( t, knotSpanIndex, p, knotVector, basisValues ); break;
+    case 5: detail::evaluateNonzeroBSplineBasis<5>( t, knotSpanIndex, p, knotVector, basisValues ); break;
+    default: detail::evaluateNonzeroBSplineBasis<0>( t, knotSpanIndex, p, knotVector, basisValues );
+  }
+}
+
+void evaluateNonzeroBSplineBasisDerivatives( double t,
+                                             size_t knotSpanIndex,
+                                             size_t p,
+                                             size_t numberOfDerivatives,
+                                             const std::vector<double>& knotVector,
+                                             double* basisDerivatives,
+                                             double* workspace )
+{
+  size_t size = p + 1;
+
+  // ndu stores the basis functions (upper triangle) and the knot differences (lower triangle),
+  // a stores the two most recently computed rows of derivative coefficients.
+  double* ndu = workspace;
+  double* a[2] = { workspace + size * size, workspace + size * size + size };
+
+  ndu[0] = 1.0;
+
+  for( size_t j = 1; j <= p; ++j )
+  {
+    double saved = 0.0;
+
+    for( size_t r = 0; r < j; ++r )
+    {
+      double right = knotVector[knotSpanIndex + r + 1] - t;
+      double left = t - knotVector[knotSpanIndex + r + 1 - j];
+
+      ndu[j * size + r] = right + left;
+
+      double temp = ndu[r * size + j - 1] / ndu[j * size + r];
+
+      ndu[r * size + j] = saved + right * temp;
+      saved = left * temp;
+    }
+
+    ndu[j * size + j] = saved;
+  }
+
+  for( size_t j = 0; j <= p; ++j )
+  {
+    basisDerivatives[j] = ndu[j * size + p];
+  }
+
+  // Derivatives higher than p vanish
+  size_t numberOfNonzeroDerivatives = std::min( numberOfDerivatives, p );
+
+  std::fill( basisDerivatives + ( numberOfNonzeroDerivatives + 1 ) * size,
+             basisDerivatives + ( numberOfDerivatives + 1 ) * size, 0.0 );
+
+  int degree = static_cast<int>( p );
+
+  for( int r = 0; r <= degree; ++r )
+  {
+    int s1 = 0;
+    int s2 = 1;
+
+    a[0][0] = 1.0;
+
+    for( int k = 1; k <= static_cast<int>( numberOfNonzeroDerivatives ); ++k )
+    {
+      double d = 0.0;
+      int rk = r - k;
+      int pk = degree - k;
+
+      if( r >= k )
+      {
+        a[s2][0] = a[s1][0] / ndu[( pk + 1 ) * size + rk];
+        d = a[s2][0] * ndu[rk * size + pk];
+      }
+
+      int j1 = rk >= -1 ? 1 : -rk;
+      int j2 = r - 1 <= pk ? k - 1 : degree - r;
+
+      for( int j = j1; j <= j2; ++j )
+      {
+        a[s2][j] = ( a[s1][j] - a[s1][j - 1] ) / ndu[( pk + 1 ) * size + rk + j];
+        d += a[s2][j] * ndu[( rk + j ) * size + pk];
+      }
+
+      if( r <= pk )
+      {
+        a[s2][k] = -a[s1][k - 1] / ndu[( pk + 1 ) * size + r];
+        d += a[s2][k] * ndu[r * size + pk];
+      }
+
+      basisDerivatives[k * size + r] = d;
+
+      std::swap( s1, s2 );
+    }
+  }
+
+  // Multiply by the correct factors p! / ( p - k )!
+  double factor = static_cast<double>( p );
+
+  for( size_t k = 1; k <= numberOfNonzeroDerivatives; ++k )
+  {
+    for( size_t j = 0; j <= p; ++j )
+    {
+      basisDerivatives[k * size + j] *= factor;
+    }
+
+    factor *= p - k;
+  }
+}
+
+BasisFunctionDerivatives evaluateBSplineBasisDerivatives( const std::vector<double>& tCoordinates,
+                                                          size_t p,
+                                                          size_t numberOfDerivatives,
+                                                          const std::vector<double>& knotVector )
+{
+  SPLINEKERNEL_TIME_SCOPE( "evaluateBSplineBasisDerivatives", tCoordinates.size( ) );
+
+  if( knotVector.size( ) < 2 * ( p + 1 ) )
+  {
+    throw std::runtime_error( "Knot vector too short for polynomial degree " + std::to_string( p ) + "." );
+  }
+
+  size_t numberOfSamples = tCoordinates.size( );
+  size_t numberOfControlPoints = knotVector.size( ) - p - 1;
+  size_t blockSize = ( numberOfDerivatives + 1 ) * ( p + 1 );
+
+  BasisFunctionDerivatives result;
+
+  result.polynomialDegree = p;
+  result.numberOfDerivatives = numberOfDerivatives;
+  result.knotSpans.resize( numberOfSamples );
+  result.values.resize( numberOfSamples * blockSize );
+
+  std::vector<double> workspace( ( p + 1 ) * ( p + 3 ) );
+
+  KnotSpanCursor cursor( numberOfControlPoints, knotVector );
+
+  for( size_t i = 0; i < numberOfSamples; ++i )
+  {
+    double t = tCoordinates[i];
+    size_t span = cursor.find( t );
+
+    evaluateNonzeroBSplineBasisDerivatives( t, span, p, numberOfDerivatives, knotVector,
+                                            result.values.data( ) + i * blockSize, workspace.data( ) );
+
+    result.knotSpans[i] = span;
+  }
+
+  return result;
+}
+
 } // namespace splinekernel
 } // namespace cie
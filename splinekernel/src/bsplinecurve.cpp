@@ -0,0 +1,112 @@
+#include "bsplinecurve.hpp"
+#include "instrumentation.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+BSplineCurve::BSplineCurve( const std::vector<double>& xCoordinates,
+                            const std::vector<double>& yCoordinates,
+                            const std::vector<double>& knotVector ) :
+    BSplineCurve( xCoordinates, yCoordinates, KnotVector( xCoordinates.size( ), knotVector ) )
+{ }
+
+BSplineCurve::BSplineCurve( const std::vector<double>& xCoordinates,
+                            const std::vector<double>& yCoordinates,
+                            const KnotVector& knotVector ) :
+    m_knotVector( knotVector ),
+    m_xCoordinates( xCoordinates ),
+    m_yCoordinates( yCoordinates )
+{
+    if( xCoordinates.size( ) != knotVector.numberOfControlPoints( ) ||
+        yCoordinates.size( ) != knotVector.numberOfControlPoints( ) )
+    {
+        throw std::runtime_error( "Inconsistent size in BSplineCurve." );
+    }
+}
+
+size_t BSplineCurve::numberOfControlPoints( ) const
+{
+    return m_knotVector.numberOfControlPoints( );
+}
+
+size_t BSplineCurve::polynomialDegree( ) const
+{
+    return m_knotVector.polynomialDegree( );
+}
+
+const KnotVector& BSplineCurve::knotVector( ) const
+{
+    return m_knotVector;
+}
+
+const std::vector<double>& BSplineCurve::xCoordinates( ) const
+{
+    return m_xCoordinates;
+}
+
+const std::vector<double>& BSplineCurve::yCoordinates( ) const
+{
+    return m_yCoordinates;
+}
+
+std::array<double, 2> BSplineCurve::evaluate( double t ) const
+{
+    // Unclamped knot vectors extend beyond the range [t_p, t_n] in which the curve is defined
+    if( !( t >= m_knotVector.lowerBound( ) && t <= m_knotVector.upperBound( ) ) )
+    {
+        throw std::out_of_range( "t = " + std::to_string( t ) + " is outside of the curve." );
+    }
+
+    size_t knotSpanIndex = m_knotVector.findKnotSpan( t );
+
+    return deBoorOptimized( t, knotSpanIndex, polynomialDegree( ), m_knotVector.knots( ),
+                            m_xCoordinates, m_yCoordinates );
+}
+
+std::array<std::vector<double>, 2> BSplineCurve::evaluate( const std::vector<double>& tCoordinates ) const
+{
+    std::array<std::vector<double>, 2> curve;
+
+    curve[0].resize( tCoordinates.size( ) );
+    curve[1].resize( tCoordinates.size( ) );
+
+    evaluate( tCoordinates.data( ), tCoordinates.size( ), curve[0].data( ), curve[1].data( ) );
+
+    return curve;
+}
+
+void BSplineCurve::evaluate( const double* tCoordinates,
+                             size_t numberOfSamples,
+                             double* curveX,
+                             double* curveY ) const
+{
+    SPLINEKERNEL_TIME_SCOPE( "BSplineCurve::evaluate", numberOfSamples );
+
+    detail::evaluateCurveInBlocks( tCoordinates, numberOfSamples, m_xCoordinates, m_yCoordinates,
+                                   m_knotVector.knots( ), m_knotVector.uniform( ), curveX, curveY, false );
+}
+
+void BSplineCurve::stream( double tBegin,
+                           double tEnd,
+                           size_t numberOfSamples,
+                           const CurveSink& sink,
+                           size_t blockSize ) const
+{
+    stream( detail::equidistantParameterSource( tBegin, tEnd, numberOfSamples ), sink, blockSize );
+}
+
+void BSplineCurve::stream( const ParameterSource& source,
+                           const CurveSink& sink,
+                           size_t blockSize ) const
+{
+    detail::streamCurve( source, m_xCoordinates, m_yCoordinates, m_knotVector.knots( ),
+                         m_knotVector.uniform( ), sink, blockSize );
+}
+
+} // namespace splinekernel
+} // namespace cie
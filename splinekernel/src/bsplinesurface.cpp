@@ -0,0 +1,169 @@
+#include "bsplinesurface.hpp"
+
+#include <stdexcept>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace detail
+{
+
+std::array<KnotVector, 2> createKnotVectors( const std::array<std::vector<double>, 2>& knotVectors,
+                                             const VectorOfMatrices& controlPoints )
+{
+    if( controlPoints.empty( ) )
+    {
+        throw std::runtime_error( "BSplineSurface needs at least one control point component." );
+    }
+
+    return { KnotVector( controlPoints[0].size1( ), knotVectors[0] ),
+             KnotVector( controlPoints[0].size2( ), knotVectors[1] ) };
+}
+
+// numberOfSamples equidistant values in [knotVector.lowerBound( ), knotVector.upperBound( )]
+std::vector<double> equidistantSamplePoints( const KnotVector& knotVector, size_t numberOfSamples )
+{
+    double lower = knotVector.lowerBound( );
+    double upper = knotVector.upperBound( );
+
+    std::vector<double> tCoordinates( numberOfSamples, lower );
+
+    for( size_t i = 1; i < numberOfSamples; ++i )
+    {
+        tCoordinates[i] = lower + i * ( upper - lower ) / ( numberOfSamples - 1.0 );
+    }
+
+    return tCoordinates;
+}
+
+} // namespace detail
+
+BSplineSurface::BSplineSurface( const std::array<std::vector<double>, 2>& knotVectors,
+                                const VectorOfMatrices& controlPoints ) :
+    BSplineSurface( detail::createKnotVectors( knotVectors, controlPoints ), controlPoints )
+{ }
+
+BSplineSurface::BSplineSurface( const std::array<KnotVector, 2>& knotVectors,
+                                const VectorOfMatrices& controlPoints ) :
+    m_knotVectors( knotVectors ),
+    m_controlPoints( controlPoints )
+{
+    if( controlPoints.empty( ) )
+    {
+        throw std::runtime_error( "BSplineSurface needs at least one control point component." );
+    }
+
+    for( const auto& component : controlPoints )
+    {
+        if( component.size1( ) != knotVectors[0].numberOfControlPoints( ) ||
+            component.size2( ) != knotVectors[1].numberOfControlPoints( ) )
+        {
+            throw std::runtime_error( "Inconsistent size in BSplineSurface." );
+        }
+    }
+}
+
+size_t BSplineSurface::numberOfComponents( ) const
+{
+    return m_controlPoints.size( );
+}
+
+std::array<size_t, 2> BSplineSurface::numberOfControlPoints( ) const
+{
+    return { m_knotVectors[0].numberOfControlPoints( ), m_knotVectors[1].numberOfControlPoints( ) };
+}
+
+std::array<size_t, 2> BSplineSurface::polynomialDegrees( ) const
+{
+    return { m_knotVectors[0].polynomialDegree( ), m_knotVectors[1].polynomialDegree( ) };
+}
+
+const std::array<KnotVector, 2>& BSplineSurface::knotVectors( ) const
+{
+    return m_knotVectors;
+}
+
+const VectorOfMatrices& BSplineSurface::controlPoints( ) const
+{
+    return m_controlPoints;
+}
+
+std::array<EvaluationPlan, 2> BSplineSurface::createPlans( const std::vector<double>& rCoordinates,
+                                                           const std::vector<double>& sCoordinates,
+                                                           size_t numberOfDerivatives ) const
+{
+    return { EvaluationPlan( rCoordinates, m_knotVectors[0], numberOfDerivatives ),
+             EvaluationPlan( sCoordinates, m_knotVectors[1], numberOfDerivatives ) };
+}
+
+VectorOfMatrices BSplineSurface::evaluate( std::array<size_t, 2> numberOfSamplePoints ) const
+{
+    return evaluate( detail::equidistantSamplePoints( m_knotVectors[0], numberOfSamplePoints[0] ),
+                     detail::equidistantSamplePoints( m_knotVectors[1], numberOfSamplePoints[1] ) );
+}
+
+VectorOfMatrices BSplineSurface::evaluate( const std::vector<double>& rCoordinates,
+                                           const std::vector<double>& sCoordinates ) const
+{
+    return evaluate( createPlans( rCoordinates, sCoordinates ) );
+}
+
+VectorOfMatrices BSplineSurface::evaluate( const std::array<EvaluationPlan, 2>& plans ) const
+{
+    return evaluateSurface( plans, m_controlPoints );
+}
+
+SurfaceDerivatives BSplineSurface::evaluateDerivatives( std::array<size_t, 2> numberOfSamplePoints ) const
+{
+    return evaluateDerivatives( detail::equidistantSamplePoints( m_knotVectors[0], numberOfSamplePoints[0] ),
+                                detail::equidistantSamplePoints( m_knotVectors[1], numberOfSamplePoints[1] ) );
+}
+
+SurfaceDerivatives BSplineSurface::evaluateDerivatives( const std::vector<double>& rCoordinates,
+                                                        const std::vector<double>& sCoordinates ) const
+{
+    return evaluateDerivatives( createPlans( rCoordinates, sCoordinates, 1 ) );
+}
+
+SurfaceDerivatives BSplineSurface::evaluateDerivatives( const std::array<EvaluationPlan, 2>& plans ) const
+{
+    return evaluateSurfaceDerivatives( plans, m_controlPoints );
+}
+
+std::vector<std::vector<double>> BSplineSurface::evaluateAtPoints( const std::vector<double>& rCoordinates,
+                                                                   const std::vector<double>& sCoordinates ) const
+{
+    if( rCoordinates.size( ) != sCoordinates.size( ) )
+    {
+        throw std::runtime_error( "Inconsistent size in BSplineSurface::evaluateAtPoints." );
+    }
+
+    std::vector<std::vector<double>> result( m_controlPoints.size( ), std::vector<double>( rCoordinates.size( ) ) );
+    std::vector<double*> targets;
+
+    for( auto& component : result )
+    {
+        targets.push_back( component.data( ) );
+    }
+
+    evaluateAtPoints( rCoordinates.data( ), sCoordinates.data( ), rCoordinates.size( ), targets );
+
+    return result;
+}
+
+void BSplineSurface::evaluateAtPoints( const double* rCoordinates,
+                                       const double* sCoordinates,
+                                       size_t numberOfPoints,
+                                       const std::vector<double*>& results ) const
+{
+    if( results.size( ) != m_controlPoints.size( ) )
+    {
+        throw std::runtime_error( "Expected one result array per component in BSplineSurface::evaluateAtPoints." );
+    }
+
+    detail::evaluateSurfaceAtPoints( m_knotVectors, m_controlPoints, rCoordinates, sCoordinates, numberOfPoints, results );
+}
+
+} // namespace splinekernel
+} // namespace cie
@@ -1,48 +1,477 @@
 #include "basisfunctions.hpp"
 #include "curve.hpp"
+#include "instrumentation.hpp"
+#include "threadpool.hpp"
+#include "uniformknotvector.hpp"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <stdexcept>
 #include <string>
 
 namespace cie
 {
 namespace splinekernel
 {
+namespace detail
+{
 
-std::array<std::vector<double>, 2> evaluate2DCurve( const std::vector<double>& tCoordinates, 
-                                                    const std::vector<double>& xCoordinates,
-                                                    const std::vector<double>& yCoordinates, 
-                                                    const std::vector<double>& knotVector )
+// Minimum number of samples evaluated by one thread
+const size_t sampleGrainSize = 512;
+
+// Number of samples evaluated together by the blocked kernels below. Their innermost loops run
+// over these lanes with a fixed trip count on structure of arrays data (index j * simdWidth + lane),
+// so the compiler maps them onto vector registers (two AVX2 or one AVX-512 register of doubles).
+const size_t simdWidth = 8;
+
+// Finds the knot span of t for the kernels below, which access the control points s - p to s.
+// Unclamped knot vectors also have spans before t_p and after t_n, where the curve is not defined.
+size_t curveKnotSpan( double t,
+                      size_t numberOfControlPoints,
+                      const UniformKnotVector& uniform,
+                      KnotSpanCursor& cursor )
+{
+    size_t span = uniform.isUniform( ) ? uniform.findKnotSpan( t ) : cursor.find( t );
+
+    if( span < uniform.polynomialDegree( ) || span >= numberOfControlPoints )
+    {
+        throw std::out_of_range( "t = " + std::to_string( t ) + " is outside of the curve." );
+    }
+
+    return span;
+}
+
+// Gathers parameter coordinates and knot spans of the block starting at sample i, where knotSpan
+// returns the span of a sample index. Lanes past the end repeat the last sample, so every sample
+// takes the same path no matter how chunks are cut.
+template<typename KnotSpan>
+size_t gatherSampleBlock( const double* tCoordinates,
+                          size_t i,
+                          size_t end,
+                          KnotSpan&& knotSpan,
+                          double* t,
+                          size_t* spans )
+{
+    size_t size = std::min( simdWidth, end - i );
+
+    for( size_t lane = 0; lane < simdWidth; ++lane )
+    {
+        if( lane < size )
+        {
+            t[lane] = tCoordinates[i + lane];
+            spans[lane] = knotSpan( i + lane );
+        }
+        else
+        {
+            t[lane] = t[size - 1];
+            spans[lane] = spans[size - 1];
+        }
+    }
+
+    return size;
+}
+
+// The block kernels below are templates over the polynomial degree P. For 1 <= P <= 5 all loop
+// bounds are compile time constants, so the compiler fully unrolls the triangular recurrences and
+// keeps the intermediate values in fixed size local arrays. P = 0 denotes the generic version that
+// uses the runtime degree p and a workspace of 2 * ( p + 1 ) * simdWidth values given by the caller.
+typedef void ( *CurveBlockKernel )( const double* t,
+                                    const size_t* spans,
+                                    size_t p,
+                                    const std::vector<double>& knotVector,
+                                    const std::vector<double>& xCoordinates,
+                                    const std::vector<double>& yCoordinates,
+                                    double* curveX,
+                                    double* curveY,
+                                    const UniformKnotVector& uniform,
+                                    double* workspace );
+
+// Blocked version of evaluateNonzeroBSplineBasis followed by the sum over the control points
+template<size_t P>
+void basisBlock( const double* t,
+                 const size_t* spans,
+                 size_t p,
+                 const std::vector<double>& knotVector,
+                 const std::vector<double>& xCoordinates,
+                 const std::vector<double>& yCoordinates,
+                 double* curveX,
+                 double* curveY,
+                 const UniformKnotVector& uniform,
+                 double* workspace )
+{
+    const size_t degree = P == 0 ? p : P;
+
+    double localN[( P + 1 ) * simdWidth];
+    double saved[simdWidth];
+
+    double* N = P == 0 ? workspace : localN;
+
+    bool uniformLanes[simdWidth];
+    size_t numberOfUniformLanes = 0;
+
+    for( size_t lane = 0; lane < simdWidth; ++lane )
+    {
+        uniformLanes[lane] = uniform.hasUniformBasis( spans[lane] );
+        numberOfUniformLanes += uniformLanes[lane];
+    }
+
+    if( numberOfUniformLanes < simdWidth )
+    {
+        std::fill( N, N + simdWidth, 1.0 );
+
+        for( size_t j = 1; j < degree + 1; ++j )
+        {
+            std::fill( saved, saved + simdWidth, 0.0 );
+
+            for( size_t r = 0; r < j; ++r )
+            {
+                double* Nr = N + r * simdWidth;
+
+                for( size_t lane = 0; lane < simdWidth; ++lane )
+                {
+                    double right = knotVector[spans[lane] + r + 1] - t[lane];
+                    double left = t[lane] - knotVector[spans[lane] + r + 1 - j];
+
+                    double temp = Nr[lane] / ( right + left );
+
+                    Nr[lane] = saved[lane] + right * temp;
+                    saved[lane] = left * temp;
+                }
+            }
+
+            std::copy( saved, saved + simdWidth, N + j * simdWidth );
+        }
+    }
+
+    // Lanes in spans of a uniform knot vector evaluate the precomputed basis polynomials instead.
+    // The choice is made per lane, so results do not depend on the other samples in the block.
+    if( numberOfUniformLanes > 0 )
+    {
+        const double* M = uniform.basisMatrix( ).data( );
+
+        double u[simdWidth];
+        double value[simdWidth];
+
+        for( size_t lane = 0; lane < simdWidth; ++lane )
+        {
+            u[lane] = ( t[lane] - knotVector[spans[lane]] ) / uniform.knotDistance( );
+        }
+
+        for( size_t j = 0; j < degree + 1; ++j )
+        {
+            const double* coefficients = M + j * ( degree + 1 );
+
+            std::fill( value, value + simdWidth, coefficients[degree] );
+
+            for( size_t k = degree; k > 0; --k )
+            {
+                for( size_t lane = 0; lane < simdWidth; ++lane )
+                {
+                    value[lane] = value[lane] * u[lane] + coefficients[k - 1];
+                }
+            }
+
+            double* Nj = N + j * simdWidth;
+
+            for( size_t lane = 0; lane < simdWidth; ++lane )
+            {
+                Nj[lane] = uniformLanes[lane] ? value[lane] : Nj[lane];
+            }
+        }
+    }
+
+    std::fill( curveX, curveX + simdWidth, 0.0 );
+    std::fill( curveY, curveY + simdWidth, 0.0 );
+
+    for( size_t j = 0; j < degree + 1; ++j )
+    {
+        const double* Nj = N + j * simdWidth;
+
+        for( size_t lane = 0; lane < simdWidth; ++lane )
+        {
+            curveX[lane] += Nj[lane] * xCoordinates[spans[lane] - degree + j];
+            curveY[lane] += Nj[lane] * yCoordinates[spans[lane] - degree + j];
+        }
+    }
+}
+
+// Blocked version of deBoorOptimized
+template<size_t P>
+void deBoorBlock( const double* t,
+                  const size_t* spans,
+                  size_t p,
+                  const std::vector<double>& knotVector,
+                  const std::vector<double>& xCoordinates,
+                  const std::vector<double>& yCoordinates,
+                  double* curveX,
+                  double* curveY,
+                  const UniformKnotVector&,
+                  double* workspace )
+{
+    const size_t degree = P == 0 ? p : P;
+
+    double localWorkspace[2 * ( P + 1 ) * simdWidth];
+
+    double* dx = P == 0 ? workspace : localWorkspace;
+    double* dy = dx + ( degree + 1 ) * simdWidth;
+
+    for( size_t j = 0; j < degree + 1; ++j )
+    {
+        for( size_t lane = 0; lane < simdWidth; ++lane )
+        {
+            dx[j * simdWidth + lane] = xCoordinates[j + spans[lane] - degree];
+            dy[j * simdWidth + lane] = yCoordinates[j + spans[lane] - degree];
+        }
+    }
+
+    for( size_t r = 1; r < degree + 1; ++r )
+    {
+        for( size_t j = degree; j > r - 1; --j )
+        {
+            double* dxj = dx + j * simdWidth;
+            double* dyj = dy + j * simdWidth;
+            const double* dxPrevious = dxj - simdWidth;
+            const double* dyPrevious = dyj - simdWidth;
+
+            for( size_t lane = 0; lane < simdWidth; ++lane )
+            {
+                double tj = knotVector[j + spans[lane] - degree];
+                double alpha = ( tj - t[lane] ) / ( tj - knotVector[j + spans[lane] + 1 - r] );
+
+                dxj[lane] = ( 1.0 - alpha ) * dxPrevious[lane] + alpha * dxj[lane];
+                dyj[lane] = ( 1.0 - alpha ) * dyPrevious[lane] + alpha * dyj[lane];
+            }
+        }
+    }
+
+    std::copy( dx + degree * simdWidth, dx + ( degree + 1 ) * simdWidth, curveX );
+    std::copy( dy + degree * simdWidth, dy + ( degree + 1 ) * simdWidth, curveY );
+}
+
+template<size_t P>
+CurveBlockKernel curveBlockKernel( bool useDeBoor )
+{
+    return useDeBoor ? &deBoorBlock<P> : &basisBlock<P>;
+}
+
+// Runtime dispatch to the kernel specialized for degree p, or to the generic one
+CurveBlockKernel selectCurveBlockKernel( size_t p, bool useDeBoor )
+{
+    switch( p )
+    {
+        case 1: return curveBlockKernel<1>( useDeBoor );
+        case 2: return curveBlockKernel<2>( useDeBoor );
+        case 3: return curveBlockKernel<3>( useDeBoor );
+        case 4: return curveBlockKernel<4>( useDeBoor );
+        case 5: return curveBlockKernel<5>( useDeBoor );
+        default: return curveBlockKernel<0>( useDeBoor );
+    }
+}
+
+void evaluateCurveInBlocks( const double* tCoordinates,
+                            size_t numberOfSamples,
+                            const std::vector<double>& xCoordinates,
+                            const std::vector<double>& yCoordinates,
+                            const std::vector<double>& knotVector,
+                            const UniformKnotVector& uniform,
+                            double* curveX,
+                            double* curveY,
+                            bool useDeBoor )
+{
+    size_t numberOfPoints = xCoordinates.size( );
+    size_t p = uniform.polynomialDegree( );
+
+    CurveBlockKernel kernel = selectCurveBlockKernel( p, useDeBoor );
+
+    // Samples are independent, so chunks of them are evaluated in parallel
+    parallelFor( 0, numberOfSamples, sampleGrainSize, [&]( size_t chunkBegin, size_t chunkEnd )
+    {
+        // Only used by the generic kernel, allocated once per chunk and reused for every block
+        std::vector<double> workspace( p == 0 || p > 5 ? 2 * ( p + 1 ) * simdWidth : 0 );
+
+        double t[simdWidth], x[simdWidth], y[simdWidth];
+        size_t spans[simdWidth];
+
+        KnotSpanCursor cursor( numberOfPoints, knotVector );
+
+        auto findSpan = [&]( size_t i ) { return curveKnotSpan( tCoordinates[i], numberOfPoints, uniform, cursor ); };
+
+#ifdef SPLINEKERNEL_ENABLE_INSTRUMENTATION
+        // Find the knot spans of the whole chunk before evaluating it, such that both stages are timed
+        // once per chunk. Without instrumentation, spans are found block by block in the same pass.
+        std::vector<size_t> chunkSpans( chunkEnd - chunkBegin );
+
+        {
+            SPLINEKERNEL_TIME_SCOPE( "curve/knot span search", chunkEnd - chunkBegin );
+
+            for( size_t i = chunkBegin; i < chunkEnd; ++i )
+            {
+                chunkSpans[i - chunkBegin] = findSpan( i );
+            }
+        }
+
+        auto knotSpan = [&]( size_t i ) { return chunkSpans[i - chunkBegin]; };
+
+        SPLINEKERNEL_TIME_SCOPE( "curve/evaluation", chunkEnd - chunkBegin );
+#else
+        auto& knotSpan = findSpan;
+#endif
+
+        for( size_t i = chunkBegin; i < chunkEnd; i += simdWidth )
+        {
+            size_t size = gatherSampleBlock( tCoordinates, i, chunkEnd, knotSpan, t, spans );
+
+            kernel( t, spans, p, knotVector, xCoordinates, yCoordinates, x, y, uniform, workspace.data( ) );
+
+            std::copy( x, x + size, curveX + i );
+            std::copy( y, y + size, curveY + i );
+        }
+    } );
+}
+
+// Shared implementation of evaluate2DCurve and evaluate2DCurveDeBoor
+void evaluateCurve( const double* tCoordinates,
+                    size_t numberOfSamples,
+                    const std::vector<double>& xCoordinates,
+                    const std::vector<double>& yCoordinates,
+                    const std::vector<double>& knotVector,
+                    double* curveX,
+                    double* curveY,
+                    bool useDeBoor,
+                    const char* name )
 {
-    size_t numberOfSamples = tCoordinates.size( );
     size_t numberOfPoints = xCoordinates.size( );
-    size_t m = knotVector.size( );
-    size_t p = m - numberOfPoints - 1;
 
-    if( yCoordinates.size( ) != numberOfPoints )
+    if( yCoordinates.size( ) != numberOfPoints || knotVector.size( ) < numberOfPoints + 1 )
     {
-        throw std::runtime_error( "Inconsistent size in evaluate2DCurve." );
+        throw std::runtime_error( std::string( "Inconsistent size in " ) + name + "." );
     }
 
-    std::vector<double> curveX( numberOfSamples, 0.0 );
-    std::vector<double> curveY( numberOfSamples, 0.0 );
-    
-    for( size_t i = 0; i < numberOfSamples; ++i )
+    UniformKnotVector uniform( numberOfPoints, knotVector );
+
+    evaluateCurveInBlocks( tCoordinates, numberOfSamples, xCoordinates, yCoordinates,
+                           knotVector, uniform, curveX, curveY, useDeBoor );
+}
+
+ParameterSource equidistantParameterSource( double tBegin, double tEnd, size_t numberOfSamples )
+{
+    size_t next = 0;
+
+    return [=]( double* tCoordinates, size_t capacity ) mutable
     {
-        double t = tCoordinates[i];
+        size_t size = std::min( capacity, numberOfSamples - next );
 
-        for( size_t j = 0; j < numberOfPoints; ++j )
+        for( size_t i = 0; i < size; ++i, ++next )
         {
-            double N = evaluateBSplineBasis( t, j, p, knotVector );
+            // The last sample is set explicitly, since rounding could move it past tEnd
+            if( next + 1 < numberOfSamples )
+            {
+                tCoordinates[i] = tBegin + next * ( tEnd - tBegin ) / ( numberOfSamples - 1.0 );
+            }
+            else
+            {
+                tCoordinates[i] = numberOfSamples > 1 ? tEnd : tBegin;
+            }
+        }
 
-            curveX[i] += N * xCoordinates[j];
-            curveY[i] += N * yCoordinates[j];
+        return size;
+    };
+}
+
+void streamCurve( const ParameterSource& source,
+                  const std::vector<double>& xCoordinates,
+                  const std::vector<double>& yCoordinates,
+                  const std::vector<double>& knotVector,
+                  const UniformKnotVector& uniform,
+                  const CurveSink& sink,
+                  size_t blockSize )
+{
+    if( blockSize == 0 )
+    {
+        throw std::runtime_error( "Block size for streaming curve evaluation must be positive." );
+    }
+
+    std::vector<double> t( blockSize ), x( blockSize ), y( blockSize );
+
+    for( size_t firstSample = 0, size; ( size = source( t.data( ), blockSize ) ) > 0; firstSample += size )
+    {
+        if( size > blockSize )
+        {
+            throw std::runtime_error( "Parameter source returned more coordinates than requested." );
         }
+
+        evaluateCurveInBlocks( t.data( ), size, xCoordinates, yCoordinates, knotVector,
+                               uniform, x.data( ), y.data( ), false );
+
+        SPLINEKERNEL_TIME_SCOPE( "curve/stream sink", size );
+
+        sink( firstSample, size, t.data( ), x.data( ), y.data( ) );
+    }
+}
+
+} // namespace detail
+
+std::array<std::vector<double>, 2> evaluate2DCurve( const std::vector<double>& tCoordinates, 
+                                                    const std::vector<double>& xCoordinates,
+                                                    const std::vector<double>& yCoordinates, 
+                                                    const std::vector<double>& knotVector )
+{
+    std::array<std::vector<double>, 2> curve;
+
+    curve[0].resize( tCoordinates.size( ) );
+    curve[1].resize( tCoordinates.size( ) );
+
+    evaluate2DCurve( tCoordinates.data( ), tCoordinates.size( ), xCoordinates, yCoordinates,
+                     knotVector, curve[0].data( ), curve[1].data( ) );
+
+    return curve;
+}
+
+void evaluate2DCurve( const double* tCoordinates,
+                      size_t numberOfSamples,
+                      const std::vector<double>& xCoordinates,
+                      const std::vector<double>& yCoordinates,
+                      const std::vector<double>& knotVector,
+                      double* curveX,
+                      double* curveY )
+{
+    SPLINEKERNEL_TIME_SCOPE( "evaluate2DCurve", numberOfSamples );
+
+    detail::evaluateCurve( tCoordinates, numberOfSamples, xCoordinates, yCoordinates,
+                           knotVector, curveX, curveY, false, "evaluate2DCurve" );
+}
+
+void stream2DCurve( double tBegin,
+                    double tEnd,
+                    size_t numberOfSamples,
+                    const std::vector<double>& xCoordinates,
+                    const std::vector<double>& yCoordinates,
+                    const std::vector<double>& knotVector,
+                    const CurveSink& sink,
+                    size_t blockSize )
+{
+    stream2DCurve( detail::equidistantParameterSource( tBegin, tEnd, numberOfSamples ),
+                   xCoordinates, yCoordinates, knotVector, sink, blockSize );
+}
+
+void stream2DCurve( const ParameterSource& source,
+                    const std::vector<double>& xCoordinates,
+                    const std::vector<double>& yCoordinates,
+                    const std::vector<double>& knotVector,
+                    const CurveSink& sink,
+                    size_t blockSize )
+{
+    size_t numberOfPoints = xCoordinates.size( );
+
+    if( yCoordinates.size( ) != numberOfPoints || knotVector.size( ) < numberOfPoints + 1 )
+    {
+        throw std::runtime_error( "Inconsistent size in stream2DCurve." );
     }
 
-    return { curveX, curveY };
+    UniformKnotVector uniform( numberOfPoints, knotVector );
+
+    detail::streamCurve( source, xCoordinates, yCoordinates, knotVector, uniform, sink, blockSize );
 }
 
 std::array<double, 2> deBoorOptimized( double t,
@@ -50,13 +479,11 @@ std::array<double, 2> deBoorOptimized( double t,
                                        size_t polynomialDegree,
                                        const std::vector<double>& knotVector,
                                        const std::vector<double>& xCoordinates,
-                                       const std::vector<double>& yCoordinates )
+                                       const std::vector<double>& yCoordinates,
+                                       double* workspace )
 {
-    // For performance reasons this should be static (or thread_local) or given by reference as target
-    std::vector<double> dx, dy;
-
-    dx.resize( polynomialDegree + 1 );
-    dy.resize( polynomialDegree + 1 );
+    double* dx = workspace;
+    double* dy = workspace + polynomialDegree + 1;
 
     for( size_t j = 0; j < polynomialDegree + 1; ++j )
     {
@@ -79,13 +506,32 @@ std::array<double, 2> deBoorOptimized( double t,
     return { dx[polynomialDegree], dy[polynomialDegree] };
 }
 
-std::array<double, 2> deBoor( double t,
-                              size_t knotSpanIndex,
-                              size_t polynomialDegree,
-                              const std::vector<double>& knotVector,
-                              const std::vector<double>& xCoordinates,
-                              const std::vector<double>& yCoordinates,
-                              size_t refinementLevel )
+std::array<double, 2> deBoorOptimized( double t,
+                                       size_t knotSpanIndex,
+                                       size_t polynomialDegree,
+                                       const std::vector<double>& knotVector,
+                                       const std::vector<double>& xCoordinates,
+                                       const std::vector<double>& yCoordinates )
+{
+    SPLINEKERNEL_TIME_SCOPE( "deBoorOptimized", 1 );
+
+    std::vector<double> workspace( 2 * ( polynomialDegree + 1 ) );
+
+    return deBoorOptimized( t, knotSpanIndex, polynomialDegree, knotVector,
+                            xCoordinates, yCoordinates, workspace.data( ) );
+}
+
+namespace detail
+{
+
+// Recursion of deBoor, which only times the outermost call
+std::array<double, 2> deBoorRecursion( double t,
+                                       size_t knotSpanIndex,
+                                       size_t polynomialDegree,
+                                       const std::vector<double>& knotVector,
+                                       const std::vector<double>& xCoordinates,
+                                       const std::vector<double>& yCoordinates,
+                                       size_t refinementLevel )
 {
     if( refinementLevel == polynomialDegree + 1 )
     {
@@ -94,8 +540,8 @@ std::array<double, 2> deBoor( double t,
 
     double a = ( t - knotVector[knotSpanIndex] ) / ( knotVector[knotSpanIndex + refinementLevel] - knotVector[knotSpanIndex] );
 
-    std::array<double, 2> P1 = deBoor( t, knotSpanIndex - 1, polynomialDegree, knotVector, xCoordinates, yCoordinates, refinementLevel + 1 );
-    std::array<double, 2> P2 = deBoor( t, knotSpanIndex, polynomialDegree, knotVector, xCoordinates, yCoordinates, refinementLevel + 1 );
+    std::array<double, 2> P1 = deBoorRecursion( t, knotSpanIndex - 1, polynomialDegree, knotVector, xCoordinates, yCoordinates, refinementLevel + 1 );
+    std::array<double, 2> P2 = deBoorRecursion( t, knotSpanIndex, polynomialDegree, knotVector, xCoordinates, yCoordinates, refinementLevel + 1 );
 
     double Px = ( 1.0 - a ) * P1[0] + a * P2[0];
     double Py = ( 1.0 - a ) * P1[1] + a * P2[1];
@@ -103,21 +549,46 @@ std::array<double, 2> deBoor( double t,
     return { Px, Py};
 }
 
-size_t findKnotSpan( double t,
-                     size_t numberOfControlPoints,
-                     const std::vector<double>& knotVector )
+} // namespace detail
+
+std::array<double, 2> deBoor( double t,
+                              size_t knotSpanIndex,
+                              size_t polynomialDegree,
+                              const std::vector<double>& knotVector,
+                              const std::vector<double>& xCoordinates,
+                              const std::vector<double>& yCoordinates,
+                              size_t refinementLevel )
+{
+    SPLINEKERNEL_TIME_SCOPE( "deBoor", 1 );
+
+    return detail::deBoorRecursion( t, knotSpanIndex, polynomialDegree, knotVector,
+                                    xCoordinates, yCoordinates, refinementLevel );
+}
+
+namespace detail
+{
+
+void throwOutOfRange( double t, const std::vector<double>& knotVector )
+{
+    throw std::out_of_range( "t out range: t = " + std::to_string( t ) +
+                             " but can only be within " + std::to_string( knotVector.front( ) ) +
+                             " and " + std::to_string( knotVector.back( ) ) + "\n" );
+}
+
+size_t searchKnotSpan( double t,
+                       size_t numberOfControlPoints,
+                       const std::vector<double>& knotVector )
 {
     double tolerance = 1e-10;
 
-    // Check if t resides within the allowed bounds
-    if( t < knotVector.front( ) || t > knotVector.back( ) )
+    // Check if t resides within the allowed bounds, which also rejects NaN
+    if( !std::isfinite( t ) || t < knotVector.front( ) || t > knotVector.back( ) )
     {
-        throw std::out_of_range( "t out range: t = " + std::to_string( t ) +
-                                 " but can only be within " + std::to_string( knotVector.front( ) ) +
-                                 " and " + std::to_string( knotVector.back( ) ) + "\n" );
+        detail::throwOutOfRange( t, knotVector );
     }
 
-    if( std::abs( t - knotVector[numberOfControlPoints + 1] ) < tolerance )
+    // The end of the last nonzero knot span t_n belongs to the last span
+    if( std::abs( t - knotVector[numberOfControlPoints] ) < tolerance )
     {
         return numberOfControlPoints - 1;
     }
@@ -127,40 +598,97 @@ size_t findKnotSpan( double t,
     return std::distance( knotVector.begin( ), result - 1 );
 }
 
-std::array<std::vector<double>, 2> evaluate2DCurveDeBoor( const std::vector<double>& tCoordinates,
-                                                          const std::vector<double>& xCoordinates,
-                                                          const std::vector<double>& yCoordinates,
-                                                          const std::vector<double>& knotVector )
+} // namespace detail
+
+size_t findKnotSpan( double t,
+                     size_t numberOfControlPoints,
+                     const std::vector<double>& knotVector )
 {
-    size_t numberOfSamples = tCoordinates.size( );
-    size_t numberOfPoints = xCoordinates.size( );
-    size_t m = knotVector.size( );
-    size_t p = m - numberOfPoints - 1;
+    SPLINEKERNEL_TIME_SCOPE( "findKnotSpan", 1 );
 
-    if( yCoordinates.size( ) != numberOfPoints )
+    return detail::searchKnotSpan( t, numberOfControlPoints, knotVector );
+}
+
+KnotSpanCursor::KnotSpanCursor( size_t numberOfControlPoints,
+                                const std::vector<double>& knotVector ) :
+    m_knotVector( knotVector ),
+    m_numberOfControlPoints( numberOfControlPoints ),
+    m_knotSpanIndex( 0 )
+{ }
+
+size_t KnotSpanCursor::find( double t )
+{
+    double tolerance = 1e-10;
+
+    const std::vector<double>& knotVector = m_knotVector;
+
+    if( !std::isfinite( t ) || t < knotVector.front( ) || t > knotVector.back( ) )
     {
-        throw std::runtime_error( "Inconsistent size in evaluate2DCurveDeBoor." );
+        detail::throwOutOfRange( t, knotVector );
     }
 
-    std::vector<double> curveX( numberOfSamples, 0.0 );
-    std::vector<double> curveY( numberOfSamples, 0.0 );
-
-    for( size_t i = 0; i < numberOfSamples; ++i )
+    if( std::abs( t - knotVector[m_numberOfControlPoints] ) < tolerance )
     {
-        double t = tCoordinates[i];
+        return m_knotSpanIndex = m_numberOfControlPoints - 1;
+    }
 
-        for( size_t j = 0; j < numberOfPoints; ++j )
-        {
-            size_t s = findKnotSpan( t, numberOfPoints, knotVector );
+    auto begin = knotVector.begin( );
+    auto end = knotVector.end( );
 
-            std::array<double, 2> Point = deBoor( t, s, p, knotVector, xCoordinates, yCoordinates );
+    if( t >= knotVector[m_knotSpanIndex] )
+    {
+        // Exponential search for the first knot greater than t starting at the previous span
+        size_t size = knotVector.size( );
+        size_t lower = m_knotSpanIndex + 1;
+        size_t step = 1;
 
-            curveX[i] = Point[0];
-            curveY[i] = Point[1];
+        while( lower + step < size && knotVector[lower + step - 1] <= t )
+        {
+            lower += step;
+            step *= 2;
         }
+
+        begin += lower;
+        end = knotVector.begin( ) + std::min( lower + step, size );
+    }
+    else
+    {
+        end = knotVector.begin( ) + m_knotSpanIndex;
     }
 
-    return { curveX, curveY};
+    auto result = std::upper_bound( begin, end, t );
+
+    return m_knotSpanIndex = std::distance( knotVector.begin( ), result - 1 );
+}
+
+std::array<std::vector<double>, 2> evaluate2DCurveDeBoor( const std::vector<double>& tCoordinates,
+                                                          const std::vector<double>& xCoordinates,
+                                                          const std::vector<double>& yCoordinates,
+                                                          const std::vector<double>& knotVector )
+{
+    std::array<std::vector<double>, 2> curve;
+
+    curve[0].resize( tCoordinates.size( ) );
+    curve[1].resize( tCoordinates.size( ) );
+
+    evaluate2DCurveDeBoor( tCoordinates.data( ), tCoordinates.size( ), xCoordinates, yCoordinates,
+                           knotVector, curve[0].data( ), curve[1].data( ) );
+
+    return curve;
+}
+
+void evaluate2DCurveDeBoor( const double* tCoordinates,
+                            size_t numberOfSamples,
+                            const std::vector<double>& xCoordinates,
+                            const std::vector<double>& yCoordinates,
+                            const std::vector<double>& knotVector,
+                            double* curveX,
+                            double* curveY )
+{
+    SPLINEKERNEL_TIME_SCOPE( "evaluate2DCurveDeBoor", numberOfSamples );
+
+    detail::evaluateCurve( tCoordinates, numberOfSamples, xCoordinates, yCoordinates,
+                           knotVector, curveX, curveY, true, "evaluate2DCurveDeBoor" );
 }
 
 } // namespace splinekernel
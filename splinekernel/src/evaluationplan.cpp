@@ -0,0 +1,182 @@
+#include "evaluationplan.hpp"
+#include "basisfunctions.hpp"
+#include "curve.hpp"
+#include "instrumentation.hpp"
+#include "knotvector.hpp"
+#include "threadpool.hpp"
+#include "uniformknotvector.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+EvaluationPlan::EvaluationPlan( const std::vector<double>& tCoordinates,
+                                size_t numberOfControlPoints,
+                                const std::vector<double>& knotVector,
+                                size_t numberOfDerivatives ) :
+    m_numberOfControlPoints( numberOfControlPoints ),
+    m_numberOfDerivatives( numberOfDerivatives )
+{
+    SPLINEKERNEL_TIME_SCOPE( "EvaluationPlan", tCoordinates.size( ) );
+
+    if( knotVector.size( ) < numberOfControlPoints + 2 )
+    {
+        throw std::runtime_error( "Inconsistent size in EvaluationPlan." );
+    }
+
+    m_polynomialDegree = knotVector.size( ) - numberOfControlPoints - 1;
+
+    // Uniform knot vectors find spans in O(1) and evaluate precomputed basis polynomials
+    UniformKnotVector uniform( numberOfControlPoints, knotVector );
+
+    evaluateBasis( tCoordinates, knotVector, uniform );
+}
+
+EvaluationPlan::EvaluationPlan( const std::vector<double>& tCoordinates,
+                                const KnotVector& knotVector,
+                                size_t numberOfDerivatives ) :
+    m_numberOfControlPoints( knotVector.numberOfControlPoints( ) ),
+    m_polynomialDegree( knotVector.polynomialDegree( ) ),
+    m_numberOfDerivatives( numberOfDerivatives )
+{
+    SPLINEKERNEL_TIME_SCOPE( "EvaluationPlan", tCoordinates.size( ) );
+
+    evaluateBasis( tCoordinates, knotVector.knots( ), knotVector.uniform( ) );
+}
+
+void EvaluationPlan::evaluateBasis( const std::vector<double>& tCoordinates,
+                                    const std::vector<double>& knotVector,
+                                    const UniformKnotVector& uniform )
+{
+    size_t numberOfSamples = tCoordinates.size( );
+    size_t size = m_polynomialDegree + 1;
+
+    m_firstControlPoints.resize( numberOfSamples );
+    m_basisValues.resize( numberOfSamples * size );
+    m_derivativeValues.resize( numberOfSamples * m_numberOfDerivatives * size );
+
+    KnotSpanCursor cursor( m_numberOfControlPoints, knotVector );
+
+    // Function values and derivatives of one sample, see evaluateNonzeroBSplineBasisDerivatives
+    std::vector<double> derivatives( m_numberOfDerivatives > 0 ? ( m_numberOfDerivatives + 1 ) * size : 0 );
+    std::vector<double> workspace( m_numberOfDerivatives > 0 ? size * ( size + 2 ) : 0 );
+
+    for( size_t i = 0; i < numberOfSamples; ++i )
+    {
+        double t = tCoordinates[i];
+        size_t s = uniform.isUniform( ) ? uniform.findKnotSpan( t ) : cursor.find( t );
+
+        // Unclamped knot vectors have spans before t_p and after t_n, which lack p + 1 basis functions
+        if( s < m_polynomialDegree || s >= m_numberOfControlPoints )
+        {
+            throw std::out_of_range( "t = " + std::to_string( t ) + " is outside of the range in which "
+                                     "all basis functions of the EvaluationPlan are defined." );
+        }
+
+        if( m_numberOfDerivatives == 0 )
+        {
+            uniform.evaluateNonzeroBasis( t, s, &m_basisValues[i * size] );
+        }
+        else
+        {
+            evaluateNonzeroBSplineBasisDerivatives( t, s, m_polynomialDegree, m_numberOfDerivatives,
+                                                    knotVector, derivatives.data( ), workspace.data( ) );
+
+            std::copy( derivatives.begin( ), derivatives.begin( ) + size, &m_basisValues[i * size] );
+            std::copy( derivatives.begin( ) + size, derivatives.end( ), &m_derivativeValues[i * m_numberOfDerivatives * size] );
+        }
+
+        m_firstControlPoints[i] = s - m_polynomialDegree;
+    }
+}
+
+size_t EvaluationPlan::numberOfSamples( ) const
+{
+    return m_firstControlPoints.size( );
+}
+
+size_t EvaluationPlan::numberOfControlPoints( ) const
+{
+    return m_numberOfControlPoints;
+}
+
+size_t EvaluationPlan::polynomialDegree( ) const
+{
+    return m_polynomialDegree;
+}
+
+size_t EvaluationPlan::numberOfDerivatives( ) const
+{
+    return m_numberOfDerivatives;
+}
+
+size_t EvaluationPlan::firstControlPoint( size_t iSample ) const
+{
+    return m_firstControlPoints[iSample];
+}
+
+const double* EvaluationPlan::basisValues( size_t iSample ) const
+{
+    return &m_basisValues[iSample * ( m_polynomialDegree + 1 )];
+}
+
+const double* EvaluationPlan::basisDerivatives( size_t iSample, size_t k ) const
+{
+    if( k == 0 )
+    {
+        return basisValues( iSample );
+    }
+
+    return &m_derivativeValues[( iSample * m_numberOfDerivatives + k - 1 ) * ( m_polynomialDegree + 1 )];
+}
+
+std::vector<double> EvaluationPlan::evaluate( const std::vector<double>& controlPointValues ) const
+{
+    if( controlPointValues.size( ) != m_numberOfControlPoints )
+    {
+        throw std::runtime_error( "Expected " + std::to_string( m_numberOfControlPoints ) +
+                                  " control point values in EvaluationPlan::evaluate." );
+    }
+
+    size_t numberOfSamples = this->numberOfSamples( );
+    size_t size = m_polynomialDegree + 1;
+
+    SPLINEKERNEL_TIME_SCOPE( "EvaluationPlan::evaluate", numberOfSamples );
+
+    std::vector<double> result( numberOfSamples, 0.0 );
+
+    // Samples are independent, chunks of at least 4096 of them are evaluated in parallel
+    parallelFor( 0, numberOfSamples, 4096, [&]( size_t chunkBegin, size_t chunkEnd )
+    {
+        for( size_t i = chunkBegin; i < chunkEnd; ++i )
+        {
+            const double* N = &m_basisValues[i * size];
+            const double* P = &controlPointValues[m_firstControlPoints[i]];
+
+            double value = 0.0;
+
+            for( size_t j = 0; j < size; ++j )
+            {
+                value += N[j] * P[j];
+            }
+
+            result[i] = value;
+        }
+    } );
+
+    return result;
+}
+
+std::array<std::vector<double>, 2> EvaluationPlan::evaluate( const std::vector<double>& xCoordinates,
+                                                             const std::vector<double>& yCoordinates ) const
+{
+    return { evaluate( xCoordinates ), evaluate( yCoordinates ) };
+}
+
+} // namespace splinekernel
+} // namespace cie
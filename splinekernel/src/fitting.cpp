@@ -0,0 +1,468 @@
+#include "fitting.hpp"
+#include "instrumentation.hpp"
+#include "threadpool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace detail
+{
+
+// Number of grid lines gathered into one block of right hand sides, small enough for the block to stay in cache
+constexpr size_t fitBlockWidth = 64;
+
+std::vector<double> equidistantParameterPositions( size_t numberOfPoints )
+{
+    std::vector<double> parameterPositions( numberOfPoints, 0.0 );
+
+    for( size_t i = 1; i < numberOfPoints; ++i )
+    {
+        parameterPositions[i] = i / ( numberOfPoints - 1.0 );
+    }
+
+    return parameterPositions;
+}
+
+const std::vector<double>& checkParameterPositions( const std::vector<double>& parameterPositions,
+                                                    const KnotVector& knotVector,
+                                                    const std::vector<double>& weights )
+{
+    if( !weights.empty( ) && ( weights.size( ) != parameterPositions.size( ) ||
+        std::any_of( weights.begin( ), weights.end( ), []( double w ) { return !( w >= 0.0 ); } ) ) )
+    {
+        throw std::runtime_error( "BSplineFit needs one non-negative weight per parameter position." );
+    }
+
+    if( parameterPositions.size( ) < knotVector.numberOfControlPoints( ) )
+    {
+        throw std::runtime_error( "BSplineFit needs at least as many parameter positions as control points." );
+    }
+
+    if( !std::is_sorted( parameterPositions.begin( ), parameterPositions.end( ) ) ||
+        parameterPositions.front( ) < knotVector.lowerBound( ) ||
+        parameterPositions.back( ) > knotVector.upperBound( ) )
+    {
+        throw std::runtime_error( "BSplineFit needs sorted parameter positions within the knot vector bounds." );
+    }
+
+    return parameterPositions;
+}
+
+BandedMatrix assembleFitMatrix( const EvaluationPlan& plan, const std::vector<double>& weights, bool interpolates )
+{
+    size_t numberOfPoints = plan.numberOfSamples( );
+    size_t numberOfControlPoints = plan.numberOfControlPoints( );
+    size_t p = plan.polynomialDegree( );
+
+    if( interpolates )
+    {
+        // Row i of the collocation matrix has its p + 1 nonzero entries from column firstControlPoint( i )
+        size_t lowerBandwidth = 0;
+        size_t upperBandwidth = 0;
+
+        for( size_t i = 0; i < numberOfPoints; ++i )
+        {
+            size_t firstColumn = plan.firstControlPoint( i );
+
+            lowerBandwidth = std::max( lowerBandwidth, i - std::min( i, firstColumn ) );
+            upperBandwidth = std::max( upperBandwidth, firstColumn + p - std::min( i, firstColumn + p ) );
+        }
+
+        BandedMatrix A( numberOfPoints, lowerBandwidth, upperBandwidth );
+
+        for( size_t i = 0; i < numberOfPoints; ++i )
+        {
+            const double* N = plan.basisValues( i );
+
+            std::copy( N, N + p + 1, &A( i, plan.firstControlPoint( i ) ) );
+        }
+
+        return A;
+    }
+
+    // Normal equations N^T W N, where two basis functions overlap if they are less than p + 1 apart
+    BandedMatrix M( numberOfControlPoints, p, p );
+
+    for( size_t i = 0; i < numberOfPoints; ++i )
+    {
+        const double* N = plan.basisValues( i );
+        size_t offset = plan.firstControlPoint( i );
+
+        double w = weights.empty( ) ? 1.0 : weights[i];
+
+        for( size_t a = 0; a <= p; ++a )
+        {
+            double wNa = w * N[a];
+
+            for( size_t b = 0; b <= p; ++b )
+            {
+                M( offset + a, offset + b ) += wNa * N[b];
+            }
+        }
+    }
+
+    return M;
+}
+
+} // namespace detail
+
+BSplineFit::BSplineFit( const std::vector<double>& parameterPositions,
+                        const KnotVector& knotVector,
+                        const std::vector<double>& weights ) :
+    m_knotVector( knotVector ),
+    m_plan( detail::checkParameterPositions( parameterPositions, knotVector, weights ), knotVector ),
+    m_matrix( 0, 0, 0 ),
+    m_weights( weights )
+{
+    SPLINEKERNEL_TIME_SCOPE( "BSplineFit", parameterPositions.size( ) );
+
+    m_matrix = detail::assembleFitMatrix( m_plan, m_weights, interpolates( ) );
+
+    // Without pivoting, since the collocation matrix is totally positive and the normal equations are positive definite
+    m_matrix.factorize( );
+}
+
+size_t BSplineFit::numberOfPoints( ) const
+{
+    return m_plan.numberOfSamples( );
+}
+
+size_t BSplineFit::numberOfControlPoints( ) const
+{
+    return m_knotVector.numberOfControlPoints( );
+}
+
+const KnotVector& BSplineFit::knotVector( ) const
+{
+    return m_knotVector;
+}
+
+bool BSplineFit::interpolates( ) const
+{
+    return numberOfPoints( ) == numberOfControlPoints( );
+}
+
+void BSplineFit::fit( const double* values, size_t numberOfRightHandSides, double* controlPoints ) const
+{
+    size_t k = numberOfRightHandSides;
+
+    if( interpolates( ) )
+    {
+        std::copy( values, values + numberOfPoints( ) * k, controlPoints );
+    }
+    else
+    {
+        // Right hand side N^T W b, accumulated point by point from the p + 1 nonzero basis functions
+        std::fill( controlPoints, controlPoints + numberOfControlPoints( ) * k, 0.0 );
+
+        size_t size = m_plan.polynomialDegree( ) + 1;
+
+        for( size_t i = 0; i < numberOfPoints( ); ++i )
+        {
+            const double* N = m_plan.basisValues( i );
+            const double* b = values + i * k;
+
+            double* target = controlPoints + m_plan.firstControlPoint( i ) * k;
+            double w = m_weights.empty( ) ? 1.0 : m_weights[i];
+
+            for( size_t a = 0; a < size; ++a )
+            {
+                double wNa = w * N[a];
+
+                for( size_t iRhs = 0; iRhs < k; ++iRhs )
+                {
+                    target[a * k + iRhs] += wNa * b[iRhs];
+                }
+            }
+        }
+    }
+
+    m_matrix.solve( controlPoints, k );
+}
+
+std::vector<double> BSplineFit::fit( const std::vector<double>& values ) const
+{
+    if( values.size( ) != numberOfPoints( ) )
+    {
+        throw std::runtime_error( "Inconsistent size in BSplineFit::fit." );
+    }
+
+    std::vector<double> controlPoints( numberOfControlPoints( ) );
+
+    fit( values.data( ), 1, controlPoints.data( ) );
+
+    return controlPoints;
+}
+
+std::vector<double> knotVectorForFitting( const std::vector<double>& parameterPositions,
+                                          size_t polynomialDegree,
+                                          size_t numberOfControlPoints )
+{
+    size_t p = polynomialDegree;
+    size_t numberOfPoints = parameterPositions.size( );
+
+    if( p == 0 || numberOfControlPoints < p + 1 || numberOfControlPoints > numberOfPoints )
+    {
+        throw std::runtime_error( "knotVectorForFitting needs a degree of at least one and between p + 1 "
+                                  "control points and one control point per parameter position." );
+    }
+
+    std::vector<double> knotVector( numberOfControlPoints + p + 1, parameterPositions.back( ) );
+
+    std::fill( knotVector.begin( ), knotVector.begin( ) + p + 1, parameterPositions.front( ) );
+
+    for( size_t j = 1; j + p < numberOfControlPoints; ++j )
+    {
+        double& knot = knotVector[p + j];
+
+        if( numberOfControlPoints == numberOfPoints )
+        {
+            knot = 0.0;
+
+            for( size_t i = j; i < j + p; ++i )
+            {
+                knot += ( 1.0 / p ) * parameterPositions[i];
+            }
+        }
+        else
+        {
+            double d = numberOfPoints / static_cast<double>( numberOfControlPoints - p );
+
+            size_t i = static_cast<size_t>( j * d );
+            double alpha = j * d - i;
+
+            knot = ( 1.0 - alpha ) * parameterPositions[i - 1] + alpha * parameterPositions[i];
+        }
+    }
+
+    return knotVector;
+}
+
+ControlPointsNDAndKnotVector approximateWithBSplineCurveND( const ControlPointsND& interpolationPoints,
+                                                            size_t polynomialDegree,
+                                                            size_t numberOfControlPoints,
+                                                            const std::vector<double>& weights,
+                                                            size_t numberOfGeometricComponents )
+{
+    size_t numberOfComponents = interpolationPoints.size( );
+
+    if( numberOfComponents == 0 || interpolationPoints[0].size( ) < 2 )
+    {
+        throw std::runtime_error( "approximateWithBSplineCurveND needs at least two points with at least one component." );
+    }
+
+    size_t numberOfPoints = interpolationPoints[0].size( );
+
+    SPLINEKERNEL_TIME_SCOPE( "approximateWithBSplineCurveND", numberOfPoints );
+
+    for( const auto& component : interpolationPoints )
+    {
+        if( component.size( ) != numberOfPoints )
+        {
+            throw std::runtime_error( "Inconsistent number of values in approximateWithBSplineCurveND." );
+        }
+    }
+
+    std::vector<double> parameterPositions = centripetalParameterPositionsND( interpolationPoints, numberOfGeometricComponents );
+    std::vector<double> knotVector = knotVectorForFitting( parameterPositions, polynomialDegree, numberOfControlPoints );
+
+    BSplineFit fit( parameterPositions, KnotVector( numberOfControlPoints, knotVector ), weights );
+
+    // Gather all components into one block of right hand sides, with the values of one point stored contiguously
+    std::vector<double> values( numberOfPoints * numberOfComponents );
+    std::vector<double> target( numberOfControlPoints * numberOfComponents );
+
+    for( size_t i = 0; i < numberOfPoints; ++i )
+    {
+        for( size_t iComponent = 0; iComponent < numberOfComponents; ++iComponent )
+        {
+            values[i * numberOfComponents + iComponent] = interpolationPoints[iComponent][i];
+        }
+    }
+
+    fit.fit( values.data( ), numberOfComponents, target.data( ) );
+
+    ControlPointsND controlPoints( numberOfComponents, std::vector<double>( numberOfControlPoints ) );
+
+    for( size_t i = 0; i < numberOfControlPoints; ++i )
+    {
+        for( size_t iComponent = 0; iComponent < numberOfComponents; ++iComponent )
+        {
+            controlPoints[iComponent][i] = target[i * numberOfComponents + iComponent];
+        }
+    }
+
+    return { std::move( controlPoints ), std::move( knotVector ) };
+}
+
+ControlPointsAndKnotVector approximateWithBSplineCurve( const ControlPoints2D& interpolationPoints,
+                                                        size_t polynomialDegree,
+                                                        size_t numberOfControlPoints,
+                                                        const std::vector<double>& weights )
+{
+    ControlPointsNDAndKnotVector result = approximateWithBSplineCurveND( { interpolationPoints[0], interpolationPoints[1] },
+                                                                         polynomialDegree, numberOfControlPoints, weights );
+
+    return { { { std::move( result.first[0] ), std::move( result.first[1] ) } }, std::move( result.second ) };
+}
+
+VectorOfMatrices fitBSplineSurface( const std::array<BSplineFit, 2>& fits,
+                                    const VectorOfMatrices& gridPoints )
+{
+    size_t numberOfPointsR = fits[0].numberOfPoints( );
+    size_t numberOfPointsS = fits[1].numberOfPoints( );
+
+    size_t numberOfControlPointsR = fits[0].numberOfControlPoints( );
+    size_t numberOfControlPointsS = fits[1].numberOfControlPoints( );
+
+    SPLINEKERNEL_TIME_SCOPE( "fitBSplineSurface", numberOfPointsR * numberOfPointsS * gridPoints.size( ) );
+
+    if( gridPoints.empty( ) )
+    {
+        throw std::runtime_error( "fitBSplineSurface needs at least one component." );
+    }
+
+    for( const auto& component : gridPoints )
+    {
+        if( component.size1( ) != numberOfPointsR || component.size2( ) != numberOfPointsS )
+        {
+            throw std::runtime_error( "Inconsistent size in fitBSplineSurface." );
+        }
+    }
+
+    VectorOfMatrices controlPoints;
+
+    for( const auto& component : gridPoints )
+    {
+        linalg::Matrix intermediate( numberOfControlPointsR, numberOfPointsS, 0.0 );
+        linalg::Matrix result( numberOfControlPointsR, numberOfControlPointsS, 0.0 );
+
+        // Fits in r-direction with each column of the grid being one right hand side
+        parallelFor( 0, numberOfPointsS, detail::fitBlockWidth, [&]( size_t chunkBegin, size_t chunkEnd )
+        {
+            std::vector<double> values( numberOfPointsR * detail::fitBlockWidth );
+            std::vector<double> target( numberOfControlPointsR * detail::fitBlockWidth );
+
+            for( size_t blockBegin = chunkBegin; blockBegin < chunkEnd; blockBegin += detail::fitBlockWidth )
+            {
+                size_t width = std::min( detail::fitBlockWidth, chunkEnd - blockBegin );
+
+                for( size_t i = 0; i < numberOfPointsR; ++i )
+                {
+                    for( size_t j = 0; j < width; ++j )
+                    {
+                        values[i * width + j] = component( i, blockBegin + j );
+                    }
+                }
+
+                fits[0].fit( values.data( ), width, target.data( ) );
+
+                for( size_t i = 0; i < numberOfControlPointsR; ++i )
+                {
+                    for( size_t j = 0; j < width; ++j )
+                    {
+                        intermediate( i, blockBegin + j ) = target[i * width + j];
+                    }
+                }
+            }
+        } );
+
+        // Fits in s-direction with each row of the intermediate result being one right hand side
+        parallelFor( 0, numberOfControlPointsR, detail::fitBlockWidth, [&]( size_t chunkBegin, size_t chunkEnd )
+        {
+            std::vector<double> values( numberOfPointsS * detail::fitBlockWidth );
+            std::vector<double> target( numberOfControlPointsS * detail::fitBlockWidth );
+
+            for( size_t blockBegin = chunkBegin; blockBegin < chunkEnd; blockBegin += detail::fitBlockWidth )
+            {
+                size_t width = std::min( detail::fitBlockWidth, chunkEnd - blockBegin );
+
+                for( size_t j = 0; j < numberOfPointsS; ++j )
+                {
+                    for( size_t i = 0; i < width; ++i )
+                    {
+                        values[j * width + i] = intermediate( blockBegin + i, j );
+                    }
+                }
+
+                fits[1].fit( values.data( ), width, target.data( ) );
+
+                for( size_t j = 0; j < numberOfControlPointsS; ++j )
+                {
+                    for( size_t i = 0; i < width; ++i )
+                    {
+                        result( blockBegin + i, j ) = target[j * width + i];
+                    }
+                }
+            }
+        } );
+
+        controlPoints.push_back( std::move( result ) );
+    }
+
+    return controlPoints;
+}
+
+SurfaceControlPointsAndKnotVectors approximateWithBSplineSurface( const std::array<std::vector<double>, 2>& parameterPositions,
+                                                                  const VectorOfMatrices& gridPoints,
+                                                                  std::array<size_t, 2> polynomialDegrees,
+                                                                  std::array<size_t, 2> numberOfControlPoints )
+{
+    std::array<std::vector<double>, 2> knotVectors
+    {
+        knotVectorForFitting( parameterPositions[0], polynomialDegrees[0], numberOfControlPoints[0] ),
+        knotVectorForFitting( parameterPositions[1], polynomialDegrees[1], numberOfControlPoints[1] )
+    };
+
+    std::array<BSplineFit, 2> fits
+    {
+        BSplineFit( parameterPositions[0], KnotVector( numberOfControlPoints[0], knotVectors[0] ) ),
+        BSplineFit( parameterPositions[1], KnotVector( numberOfControlPoints[1], knotVectors[1] ) )
+    };
+
+    return { fitBSplineSurface( fits, gridPoints ), std::move( knotVectors ) };
+}
+
+SurfaceControlPointsAndKnotVectors approximateWithBSplineSurface( const VectorOfMatrices& gridPoints,
+                                                                  std::array<size_t, 2> polynomialDegrees,
+                                                                  std::array<size_t, 2> numberOfControlPoints )
+{
+    if( gridPoints.empty( ) )
+    {
+        throw std::runtime_error( "approximateWithBSplineSurface needs at least one component." );
+    }
+
+    std::array<std::vector<double>, 2> parameterPositions
+    {
+        detail::equidistantParameterPositions( gridPoints[0].size1( ) ),
+        detail::equidistantParameterPositions( gridPoints[0].size2( ) )
+    };
+
+    return approximateWithBSplineSurface( parameterPositions, gridPoints, polynomialDegrees, numberOfControlPoints );
+}
+
+SurfaceControlPointsAndKnotVectors interpolateWithBSplineSurface( const std::array<std::vector<double>, 2>& parameterPositions,
+                                                                  const VectorOfMatrices& gridPoints,
+                                                                  std::array<size_t, 2> polynomialDegrees )
+{
+    return approximateWithBSplineSurface( parameterPositions, gridPoints, polynomialDegrees,
+                                          { parameterPositions[0].size( ), parameterPositions[1].size( ) } );
+}
+
+SurfaceControlPointsAndKnotVectors interpolateWithBSplineSurface( const VectorOfMatrices& gridPoints,
+                                                                  std::array<size_t, 2> polynomialDegrees )
+{
+    if( gridPoints.empty( ) )
+    {
+        throw std::runtime_error( "interpolateWithBSplineSurface needs at least one component." );
+    }
+
+    return approximateWithBSplineSurface( gridPoints, polynomialDegrees, { gridPoints[0].size1( ), gridPoints[0].size2( ) } );
+}
+
+} // namespace splinekernel
+} // namespace cie
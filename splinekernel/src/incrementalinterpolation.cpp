@@ -0,0 +1,280 @@
+#include "incrementalinterpolation.hpp"
+#include "basisfunctions.hpp"
+#include "curve.hpp"
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+IncrementalInterpolator::IncrementalInterpolator( size_t polynomialDegree,
+                                                  size_t numberOfComponents,
+                                                  size_t numberOfGeometricComponents ) :
+    m_polynomialDegree( polynomialDegree ),
+    m_numberOfGeometricComponents( numberOfGeometricComponents == 0 ? numberOfComponents : numberOfGeometricComponents ),
+    m_points( numberOfComponents ),
+    m_matrix( 0, polynomialDegree, polynomialDegree ),
+    m_numberOfFinalRows( 0 ),
+    m_numberOfFactorizedPoints( 0 )
+{
+    if( polynomialDegree == 0 )
+    {
+        throw std::runtime_error( "Error. Please enter a polynomial degree of at least one" );
+    }
+
+    if( numberOfComponents == 0 || m_numberOfGeometricComponents > numberOfComponents )
+    {
+        throw std::runtime_error( "Invalid number of components in IncrementalInterpolator." );
+    }
+}
+
+size_t IncrementalInterpolator::polynomialDegree( ) const
+{
+    return m_polynomialDegree;
+}
+
+size_t IncrementalInterpolator::numberOfComponents( ) const
+{
+    return m_points.size( );
+}
+
+size_t IncrementalInterpolator::numberOfPoints( ) const
+{
+    return m_lengths.size( );
+}
+
+void IncrementalInterpolator::push( const std::vector<double>& point )
+{
+    if( point.size( ) != m_points.size( ) )
+    {
+        throw std::runtime_error( "Expected " + std::to_string( m_points.size( ) ) +
+                                  " components per point in IncrementalInterpolator." );
+    }
+
+    double length = 0.0;
+
+    if( !m_lengths.empty( ) )
+    {
+        double squaredDistance = 0.0;
+
+        for( size_t iComponent = 0; iComponent < m_numberOfGeometricComponents; ++iComponent )
+        {
+            double difference = point[iComponent] - m_points[iComponent].back( );
+
+            squaredDistance += difference * difference;
+        }
+
+        length = m_lengths.back( ) + std::sqrt( std::sqrt( squaredDistance ) );
+    }
+
+    for( size_t iComponent = 0; iComponent < m_points.size( ); ++iComponent )
+    {
+        m_points[iComponent].push_back( point[iComponent] );
+    }
+
+    m_lengths.push_back( length );
+}
+
+void IncrementalInterpolator::pop( )
+{
+    for( auto& component : m_points )
+    {
+        component.pop_back( );
+    }
+
+    m_lengths.pop_back( );
+}
+
+void IncrementalInterpolator::append( const std::vector<double>& point )
+{
+    push( point );
+
+    size_t n = m_lengths.size( );
+
+    if( n >= m_polynomialDegree + 1 )
+    {
+        // Factorize the new rows, then determine the rows that no further point can change.
+        // Remove the point again if this fails, such that the previous points remain usable.
+        try
+        {
+            factorize( );
+        }
+        catch( ... )
+        {
+            pop( );
+
+            throw;
+        }
+
+        size_t p = m_polynomialDegree;
+
+        // Row i is final if its parameter position is not the last one and its nonzero basis
+        // functions only depend on the knots t_0, ..., t_{n - 1}, which are final as well.
+        while( m_numberOfFinalRows + 1 < n && ( m_numberOfFinalRows == 0 ||
+               m_knotSpans[m_numberOfFinalRows] + p + 1 <= n - 1 ) )
+        {
+            ++m_numberOfFinalRows;
+        }
+    }
+}
+
+ControlPointsNDAndKnotVector IncrementalInterpolator::interpolate( )
+{
+    // The factorization is behind after too few points or ahead after a preview
+    if( m_numberOfFactorizedPoints != m_lengths.size( ) )
+    {
+        factorize( );
+    }
+
+    return solve( );
+}
+
+ControlPointsNDAndKnotVector IncrementalInterpolator::preview( const std::vector<double>& point )
+{
+    push( point );
+
+    try
+    {
+        factorize( );
+
+        ControlPointsNDAndKnotVector result = solve( );
+
+        pop( );
+
+        return result;
+    }
+    catch( ... )
+    {
+        pop( );
+
+        throw;
+    }
+}
+
+void IncrementalInterpolator::factorize( )
+{
+    size_t n = m_lengths.size( );
+    size_t p = m_polynomialDegree;
+
+    SPLINEKERNEL_TIME_SCOPE( "IncrementalInterpolator::factorize", n - std::min( n, m_numberOfFinalRows ) );
+
+    if( n < p + 1 )
+    {
+        throw std::runtime_error( "Error. Please enter a lower polynomial degree" );
+    }
+
+    m_numberOfFactorizedPoints = 0;
+
+    // Unnormalized knot vector as in knotVectorUsingAveraging. The inner knot t_i only depends on the
+    // parameter positions before i, so the knots before the previous and the current number of
+    // points are unchanged and only the following ones are updated.
+    size_t numberOfValidKnots = std::min( m_knotVector.size( ) - std::min( m_knotVector.size( ), p + 1 ), n );
+
+    m_knotVector.resize( n + p + 1 );
+
+    for( size_t i = std::max( numberOfValidKnots, p + 1 ); i < n; ++i )
+    {
+        m_knotVector[i] = 0.0;
+
+        for( size_t j = 1; j < p + 1; ++j )
+        {
+            m_knotVector[i] += ( 1.0 / p ) * m_lengths[i - p - 1 + j];
+        }
+    }
+
+    for( size_t i = n; i < n + p + 1; ++i )
+    {
+        m_knotVector[i] = m_lengths.back( );
+    }
+
+    // Set up the rows that are not final and refactorize only these
+    size_t firstRow = m_numberOfFinalRows;
+
+    m_matrix.resize( n );
+    m_knotSpans.resize( n );
+
+    BandedMatrix& A = m_matrix;
+
+    for( size_t i = firstRow; i < n; ++i )
+    {
+        for( size_t j = i - std::min( i, p ); j <= std::min( i + p, n - 1 ); ++j )
+        {
+            A( i, j ) = 0.0;
+        }
+
+        if( i == 0 || i == n - 1 )
+        {
+            A( i, i ) = 1.0;
+            m_knotSpans[i] = i == 0 ? p : n - 1;
+
+            continue;
+        }
+
+        size_t span = detail::searchKnotSpan( m_lengths[i], n, m_knotVector );
+
+        if( span > i + p || span < i )
+        {
+            throw std::runtime_error( "Degenerate parameter positions in IncrementalInterpolator." );
+        }
+
+        evaluateNonzeroBSplineBasis( m_lengths[i], span, p, m_knotVector, &A( i, span - p ) );
+
+        m_knotSpans[i] = span;
+    }
+
+    A.factorize( firstRow );
+
+    m_numberOfFactorizedPoints = n;
+}
+
+ControlPointsNDAndKnotVector IncrementalInterpolator::solve( ) const
+{
+    size_t n = m_lengths.size( );
+    size_t numberOfComponents = m_points.size( );
+
+    SPLINEKERNEL_TIME_SCOPE( "IncrementalInterpolator::solve", n );
+
+    // Solve for all components as one block of right hand sides
+    std::vector<double> rightHandSides( n * numberOfComponents );
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        for( size_t iComponent = 0; iComponent < numberOfComponents; ++iComponent )
+        {
+            rightHandSides[i * numberOfComponents + iComponent] = m_points[iComponent][i];
+        }
+    }
+
+    m_matrix.solve( rightHandSides.data( ), numberOfComponents );
+
+    ControlPointsND controlPoints( numberOfComponents, std::vector<double>( n ) );
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        for( size_t iComponent = 0; iComponent < numberOfComponents; ++iComponent )
+        {
+            controlPoints[iComponent][i] = rightHandSides[i * numberOfComponents + iComponent];
+        }
+    }
+
+    // Scale the knot vector back to [0, 1]
+    std::vector<double> knotVector = m_knotVector;
+
+    double totalLength = m_lengths.back( );
+
+    for( double& knot : knotVector )
+    {
+        knot /= totalLength;
+    }
+
+    return { controlPoints, knotVector };
+}
+
+} // namespace splinekernel
+} // namespace cie
@@ -0,0 +1,81 @@
+#include "instrumentation.hpp"
+
+#include <map>
+#include <mutex>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace detail
+{
+
+struct InstrumentationRegistry
+{
+    std::mutex mutex;
+
+    // Nodes of a map do not move, so references to the counters stay valid
+    std::map<std::string, InstrumentationCounter> counters;
+};
+
+InstrumentationRegistry& instrumentationRegistry( )
+{
+    static InstrumentationRegistry registry;
+
+    return registry;
+}
+
+InstrumentationCounter& instrumentationCounter( const std::string& name )
+{
+    InstrumentationRegistry& registry = instrumentationRegistry( );
+
+    std::lock_guard<std::mutex> lock( registry.mutex );
+
+    return registry.counters[name];
+}
+
+} // namespace detail
+
+bool instrumentationEnabled( )
+{
+#ifdef SPLINEKERNEL_ENABLE_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::vector<InstrumentationRecord> instrumentationReport( )
+{
+    detail::InstrumentationRegistry& registry = detail::instrumentationRegistry( );
+
+    std::lock_guard<std::mutex> lock( registry.mutex );
+
+    std::vector<InstrumentationRecord> report;
+
+    for( const auto& entry : registry.counters )
+    {
+        const detail::InstrumentationCounter& counter = entry.second;
+
+        report.push_back( { entry.first, counter.numberOfCalls, counter.numberOfSamples, 1e-9 * counter.nanoseconds } );
+    }
+
+    return report;
+}
+
+void resetInstrumentation( )
+{
+    detail::InstrumentationRegistry& registry = detail::instrumentationRegistry( );
+
+    std::lock_guard<std::mutex> lock( registry.mutex );
+
+    for( auto& entry : registry.counters )
+    {
+        entry.second.numberOfCalls = 0;
+        entry.second.numberOfSamples = 0;
+        entry.second.nanoseconds = 0;
+    }
+}
+
+} // namespace splinekernel
+} // namespace cie
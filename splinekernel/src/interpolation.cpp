@@ -1,9 +1,14 @@
 #include "interpolation.hpp"
 #include "basisfunctions.hpp"
-#include "linalg.hpp"
+#include "bandedmatrix.hpp"
+#include "curve.hpp"
+#include "instrumentation.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <exception>
+#include <stdexcept>
+#include <utility>
 
 namespace cie
 {
@@ -19,28 +24,83 @@ namespace cie
 				throw std::runtime_error("error");
 			}
 
+			// interpolate x- and y-components together
+			ControlPointsNDAndKnotVector result = interpolateWithBSplineCurveND({ interpolationPoints[0], interpolationPoints[1] },
+																				polynomialDegree);
+
+			// control points is an array consisting of 2 vectors, each of size n
+			ControlPoints2D controlPoints{ { std::move(result.first[0]), std::move(result.first[1]) } };
+
+			//return control points and the knotVector
+			return { controlPoints, std::move(result.second) };
+		}
+
+		// Returns the control points for a b-spline curve interpolating points with any number of components.
+		ControlPointsNDAndKnotVector interpolateWithBSplineCurveND(const ControlPointsND& interpolationPoints,
+																   size_t polynomialDegree,
+																   size_t numberOfGeometricComponents)
+		{
+			SPLINEKERNEL_TIME_SCOPE("interpolateWithBSplineCurveND", interpolationPoints.empty() ? 0 : interpolationPoints[0].size());
+
+			// determine number of components, e.g. 3 for x, y and z
+			size_t numberOfComponents = interpolationPoints.size();
+
+			// Throw exception if there are no components
+			if (numberOfComponents == 0)
+			{
+				throw std::runtime_error("Error. Interpolation points need at least one component");
+			}
+
+			// Throw exception if the components have different numbers of values
+			for (size_t iComponent = 1; iComponent < numberOfComponents; iComponent++)
+			{
+				if (interpolationPoints[iComponent].size() != interpolationPoints[0].size())
+				{
+					throw std::runtime_error("Error. Inconsistent number of values in interpolation point components");
+				}
+			}
+
+			// Throw exception for constant B-Splines, which cannot interpolate distinct points
+			if (polynomialDegree == 0)
+			{
+				throw std::runtime_error("Error. Please enter a polynomial degree of at least one");
+			}
+
 			// determine number of given interpolation points
 			size_t numberofInterpolationPoints = interpolationPoints[0].size();
 
-			// declare vector t_bar with size equal to number of interpolation points
-			std::vector<double> t_bar(numberofInterpolationPoints);
+			// calculate t_bar from the geometric components by calling function centripetalParameterPositionsND
+			std::vector<double> t_bar = centripetalParameterPositionsND(interpolationPoints, numberOfGeometricComponents);
 
-			// calculate t_bar by calling function centripetalParameterPositions
-			t_bar = centripetalParameterPositions(interpolationPoints);
+			// calculate knot vector of size n + p + 1 by calling function knotVectorUsingAveraging
+			std::vector<double> knotVector = knotVectorUsingAveraging(t_bar, polynomialDegree);
 
-			// declare knotVector vector of size n + p + 1
-			std::vector<double> knotVector(numberofInterpolationPoints + polynomialDegree + 1);
+			// determine knot span of each parameter position. Row i of the collocation matrix
+			// only has nonzero entries in the columns knotSpans[i] - p, ..., knotSpans[i]
+			std::vector<size_t> knotSpans(numberofInterpolationPoints);
 
-			// calculate knot vector by calling function knotVectorUsingAveraging
-			knotVector = knotVectorUsingAveraging(t_bar, polynomialDegree);
+			// lower and upper bandwidth of the collocation matrix
+			size_t lowerBandwidth = 0;
+			size_t upperBandwidth = 0;
 
-			// declare square matrix "A" of size n x n
-			linalg::Matrix A(numberofInterpolationPoints, numberofInterpolationPoints, 0);
+			// parameter positions are sorted, so the spans are found by walking through the knot vector
+			KnotSpanCursor cursor(numberofInterpolationPoints, knotVector);
 
-			// control points is an array consisting of 2 vectors, each of size n
-			ControlPoints2D controlPoints;
-			controlPoints[0].reserve(numberofInterpolationPoints);
-			controlPoints[1].reserve(numberofInterpolationPoints);
+			// loop across inner rows, since first and last rows are known
+			for (size_t i = 1; i < numberofInterpolationPoints - 1; i++)
+			{
+				knotSpans[i] = cursor.find(t_bar[i]);
+
+				// first and last nonzero column of row i
+				size_t firstColumn = knotSpans[i] - polynomialDegree;
+				size_t lastColumn = knotSpans[i];
+
+				lowerBandwidth = std::max(lowerBandwidth, i - std::min(i, firstColumn));
+				upperBandwidth = std::max(upperBandwidth, lastColumn - std::min(i, lastColumn));
+			}
+
+			// declare banded matrix "A" of size n x n
+			BandedMatrix A(numberofInterpolationPoints, lowerBandwidth, upperBandwidth);
 
 			// set top left and bottom right matrix entry = 1
 			A(0, 0) = 1;
@@ -49,31 +109,67 @@ namespace cie
 			// loop across rows of matrix A. First and last rows are known
 			for (size_t i = 1; i < numberofInterpolationPoints - 1; i++)
 			{
-				// loop across columns of matrix A
-				for (size_t j = 0; j < numberofInterpolationPoints; j++)
+				// the p + 1 nonzero entries of row i are stored contiguously in the band, so they are
+				// computed in one pass by evaluateNonzeroBSplineBasis and written there directly
+				size_t firstColumn = knotSpans[i] - polynomialDegree;
+
+				evaluateNonzeroBSplineBasis(t_bar[i], knotSpans[i], polynomialDegree, knotVector, &A(i, firstColumn));
+			}
+
+			// compute LU decomposition of A once, without pivoting since A is totally positive
+			A.factorize();
+
+			// gather all components into one block of right hand sides, with the values of one point stored contiguously
+			std::vector<double> rightHandSides(numberofInterpolationPoints * numberOfComponents);
+
+			for (size_t i = 0; i < numberofInterpolationPoints; i++)
+			{
+				for (size_t iComponent = 0; iComponent < numberOfComponents; iComponent++)
 				{
-					// calculate each entry, N, of matrix A by calling evaluateBSplineBasis function
-					// to calculate N, the parameter position (t_bar), column #, p, and knot vector are needed
-					double N = evaluateBSplineBasis(t_bar[i], j, polynomialDegree, knotVector);
-					
-					// assign N to current entry of matrix A
-					A(i, j) = N;
+					rightHandSides[i * numberOfComponents + iComponent] = interpolationPoints[iComponent][i];
 				}
-
 			}
-			// solve system of equations for the x-components of the control points
-			controlPoints[0] = linalg::solve(A, interpolationPoints[0]);
 
-			// solve system of equations for the y-components of the control points
-			controlPoints[1] = linalg::solve(A, interpolationPoints[1]);
+			// solve system of equations for all components at once
+			A.solve(rightHandSides.data(), numberOfComponents);
+
+			// scatter solution into one vector of control point values per component
+			ControlPointsND controlPoints(numberOfComponents, std::vector<double>(numberofInterpolationPoints));
+
+			for (size_t i = 0; i < numberofInterpolationPoints; i++)
+			{
+				for (size_t iComponent = 0; iComponent < numberOfComponents; iComponent++)
+				{
+					controlPoints[iComponent][i] = rightHandSides[i * numberOfComponents + iComponent];
+				}
+			}
 
 			//return control points and the knotVector
-			return { {controlPoints }, {knotVector } };
+			return { controlPoints, knotVector };
 		}
 
 		// function to calculate t_bar vector using centripetal technique
 		std::vector<double> centripetalParameterPositions(const ControlPoints2D& interpolationPoints)
 		{
+			return centripetalParameterPositionsND({ interpolationPoints[0], interpolationPoints[1] });
+		}
+
+		// function to calculate t_bar vector using centripetal technique for points with any number of components
+		std::vector<double> centripetalParameterPositionsND(const ControlPointsND& interpolationPoints,
+															size_t numberOfGeometricComponents)
+		{
+			// use all components if number of geometric components is not given
+			if (numberOfGeometricComponents == 0)
+			{
+				numberOfGeometricComponents = interpolationPoints.size();
+			}
+
+			// Throw exception if more geometric components are requested than available
+			if (numberOfGeometricComponents > interpolationPoints.size())
+			{
+				throw std::runtime_error("Error. Number of geometric components exceeds number of components");
+			}
+
 			// calculate n by finding size of user-provided interpolationPoints vector
 			size_t numberOfInterpolationPoints = interpolationPoints[0].size();
 
@@ -93,19 +189,23 @@ namespace cie
 			//interpolation point and also total distance
 			for (size_t i = 0; i < numberOfInterpolationPoints - 1; i++)
 			{
-				// calculate difference in x- and y- direction
-				double differenceX = interpolationPoints[0][i + 1] - interpolationPoints[0][i];
-				double differenceY = interpolationPoints[1][i + 1] - interpolationPoints[1][i];
+				// sum up squared differences of all geometric components
+				double squaredDistance = 0;
+
+				for (size_t iComponent = 0; iComponent < numberOfGeometricComponents; iComponent++)
+				{
+					double difference = interpolationPoints[iComponent][i + 1] - interpolationPoints[iComponent][i];
+
+					squaredDistance += difference * difference;
+				}
+
+				// take square root of the euclidean distance
+				distance[i] = sqrt(sqrt(squaredDistance));
 
-				// calculate distance between each interpolation point by applying pythagorean theorem
-				// and then taking the square root
-				distance[i] = sqrt(sqrt(pow(differenceX, 2) + pow(differenceY, 2)));
-				
 				// sum up total distance in each iteration
 				totalDistance += distance[i];
-
 			}
-	   
+
 			//loop over all interpolation points - 1 to calculate parameter positions based on centripetal technique
 			for (size_t i = 1; i < numberOfInterpolationPoints; i++)
 			{
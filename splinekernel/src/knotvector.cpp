@@ -0,0 +1,133 @@
+#include "knotvector.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace detail
+{
+
+const std::vector<double>& checkKnotVector( size_t numberOfControlPoints,
+                                            const std::vector<double>& knots )
+{
+    size_t n = numberOfControlPoints;
+    size_t m = knots.size( );
+
+    if( m < n + 2 )
+    {
+        throw std::runtime_error( "Inconsistent size in KnotVector." );
+    }
+
+    if( !std::is_sorted( knots.begin( ), knots.end( ) ) )
+    {
+        throw std::runtime_error( "Knot vector is not sorted." );
+    }
+
+    size_t p = m - n - 1;
+
+    if( n <= p || !( knots[p] < knots[n] ) )
+    {
+        throw std::runtime_error( "Knot vector has no nonzero knot span." );
+    }
+
+    for( size_t i = 0; i + p + 1 < m; ++i )
+    {
+        if( knots[i] == knots[i + p + 1] )
+        {
+            throw std::runtime_error( "Knot " + std::to_string( knots[i] ) + " is repeated more than p + 1 = " +
+                                      std::to_string( p + 1 ) + " times." );
+        }
+    }
+
+    return knots;
+}
+
+} // namespace detail
+
+KnotVector::Data::Data( size_t n, const std::vector<double>& knotVector ) :
+    knots( detail::checkKnotVector( n, knotVector ) ),
+    numberOfControlPoints( n ),
+    polynomialDegree( knotVector.size( ) - n - 1 ),
+    uniform( n, knots )
+{
+    for( size_t i = 0; i < knots.size( ); ++i )
+    {
+        if( i == 0 || knots[i] != knots[i - 1] )
+        {
+            breakpoints.push_back( knots[i] );
+            multiplicities.push_back( 0 );
+        }
+
+        multiplicities.back( ) += 1;
+    }
+
+    for( size_t s = polynomialDegree; s < numberOfControlPoints; ++s )
+    {
+        if( knots[s] < knots[s + 1] )
+        {
+            nonzeroKnotSpans.push_back( s );
+        }
+    }
+}
+
+KnotVector::KnotVector( size_t numberOfControlPoints,
+                        const std::vector<double>& knots ) :
+    m_data( std::make_shared<Data>( numberOfControlPoints, knots ) )
+{ }
+
+size_t KnotVector::numberOfControlPoints( ) const
+{
+    return m_data->numberOfControlPoints;
+}
+
+size_t KnotVector::polynomialDegree( ) const
+{
+    return m_data->polynomialDegree;
+}
+
+const std::vector<double>& KnotVector::knots( ) const
+{
+    return m_data->knots;
+}
+
+const std::vector<double>& KnotVector::breakpoints( ) const
+{
+    return m_data->breakpoints;
+}
+
+const std::vector<size_t>& KnotVector::multiplicities( ) const
+{
+    return m_data->multiplicities;
+}
+
+const std::vector<size_t>& KnotVector::nonzeroKnotSpans( ) const
+{
+    return m_data->nonzeroKnotSpans;
+}
+
+double KnotVector::lowerBound( ) const
+{
+    return m_data->knots[m_data->polynomialDegree];
+}
+
+double KnotVector::upperBound( ) const
+{
+    return m_data->knots[m_data->numberOfControlPoints];
+}
+
+size_t KnotVector::findKnotSpan( double t ) const
+{
+    return m_data->uniform.findKnotSpan( t );
+}
+
+const UniformKnotVector& KnotVector::uniform( ) const
+{
+    return m_data->uniform;
+}
+
+} // namespace splinekernel
+} // namespace cie
@@ -1,5 +1,12 @@
-#include "basisfunctions.hpp"
 #include "surface.hpp"
+#include "instrumentation.hpp"
+#include "threadpool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
 
 namespace cie
 {
@@ -8,82 +15,527 @@ namespace splinekernel
 namespace detail
 {
 
-std::vector<std::vector<double>> evaluateShapeFunctions( const std::vector<double>& knotVector,
-                                                         size_t numberOfControlPoints ,
-                                                         size_t numberOfSamplePoints )
+std::vector<double> uniformSamplePoints( size_t numberOfSamplePoints )
+{
+    // A single sample point is at t = 0 instead of 0 / 0
+    std::vector<double> tCoordinates( numberOfSamplePoints, 0.0 );
+
+    for( size_t iEvaluationCoordinate = 1; iEvaluationCoordinate < numberOfSamplePoints; ++iEvaluationCoordinate )
+    {
+        tCoordinates[iEvaluationCoordinate] = iEvaluationCoordinate / ( numberOfSamplePoints - 1.0 );
+    }
+
+    return tCoordinates;
+}
+
+// The contractions below are templates over the polynomial degree P in the contracted direction.
+// For 1 <= P <= 5 the loops over the nonzero basis functions have compile time bounds and are
+// unrolled completely, P = 0 is the generic version using the degree of the evaluation plan.
+
+// Sums the p + 1 nonzero basis functions in r-direction for one sample in r
+template<size_t P>
+void contractR( const EvaluationPlan& plan,
+                size_t iR,
+                const linalg::Matrix& controlPointValues,
+                std::vector<double>& contractedR )
 {
-    std::vector<std::vector<double>> shapeFunctionValues( numberOfSamplePoints );
+    const size_t size = ( P == 0 ? plan.polynomialDegree( ) : P ) + 1;
 
-    size_t polynomialDegree = knotVector.size( ) - numberOfControlPoints - 1;
+    const double* Nr = plan.basisValues( iR );
+    size_t offsetR = plan.firstControlPoint( iR );
 
-    for( size_t iEvaluationCoordinate = 0; iEvaluationCoordinate < numberOfSamplePoints; ++iEvaluationCoordinate )
+    std::fill( contractedR.begin( ), contractedR.end( ), 0.0 );
+
+    for( size_t iCP = 0; iCP < size; ++iCP )
     {
-        shapeFunctionValues[iEvaluationCoordinate].resize( numberOfControlPoints );
+        for( size_t jCP = 0; jCP < contractedR.size( ); ++jCP )
+        {
+            contractedR[jCP] += Nr[iCP] * controlPointValues( offsetR + iCP, jCP );
+        }
+    }
+}
+
+// Sums the q + 1 nonzero basis functions in s-direction for all samples in s
+template<size_t Q>
+void contractS( const EvaluationPlan& plan,
+                const std::vector<double>& contractedR,
+                size_t iR,
+                linalg::Matrix& result )
+{
+    const size_t size = ( Q == 0 ? plan.polynomialDegree( ) : Q ) + 1;
+
+    for( size_t iS = 0; iS < plan.numberOfSamples( ); ++iS )
+    {
+        const double* Ns = plan.basisValues( iS );
+        const double* values = &contractedR[plan.firstControlPoint( iS )];
 
-        double t = iEvaluationCoordinate / ( numberOfSamplePoints - 1.0 );
+        double value = 0.0;
 
-        for( size_t iShapeFunction = 0; iShapeFunction < numberOfControlPoints; ++iShapeFunction )
+        for( size_t jCP = 0; jCP < size; ++jCP )
         {
-            double value = evaluateBSplineBasis( t, iShapeFunction, polynomialDegree, knotVector );
+            value += Ns[jCP] * values[jCP];
+        }
+
+        result( iR, iS ) = value;
+    }
+}
+
+typedef void ( *ContractionR )( const EvaluationPlan&, size_t, const linalg::Matrix&, std::vector<double>& );
+typedef void ( *ContractionS )( const EvaluationPlan&, const std::vector<double>&, size_t, linalg::Matrix& );
 
-            shapeFunctionValues[iEvaluationCoordinate][iShapeFunction] = value;
+// Runtime dispatch to the contractions specialized for the given degrees, or to the generic ones
+ContractionR selectContractionR( size_t p )
+{
+    switch( p )
+    {
+        case 1: return &contractR<1>;
+        case 2: return &contractR<2>;
+        case 3: return &contractR<3>;
+        case 4: return &contractR<4>;
+        case 5: return &contractR<5>;
+        default: return &contractR<0>;
+    }
+}
+
+ContractionS selectContractionS( size_t q )
+{
+    switch( q )
+    {
+        case 1: return &contractS<1>;
+        case 2: return &contractS<2>;
+        case 3: return &contractS<3>;
+        case 4: return &contractS<4>;
+        case 5: return &contractS<5>;
+        default: return &contractS<0>;
+    }
+}
+
+// Minimum number of scattered points evaluated by one thread
+const size_t pointGrainSize = 1024;
+
+// A point of evaluateSurfaceAtPoints, stored in the order of the knot span cells
+struct CellPoint
+{
+    double r;
+    double s;
+    size_t cell;
+    size_t index;
+};
+
+/* Groups the points by knot span cell. Counting sort is linear in the number of points and cells,
+ * so it is used unless there are many more cells than points. The coordinates are copied into the
+ * sorted records, so evaluating them afterwards reads memory sequentially.
+ */
+std::vector<CellPoint> sortByCell( const double* rCoordinates,
+                                   const double* sCoordinates,
+                                   const std::vector<size_t>& cells,
+                                   size_t numberOfCells )
+{
+    size_t numberOfPoints = cells.size( );
+
+    std::vector<CellPoint> points( numberOfPoints );
+
+    if( numberOfCells > 4 * numberOfPoints + 1024 )
+    {
+        for( size_t i = 0; i < numberOfPoints; ++i )
+        {
+            points[i] = { rCoordinates[i], sCoordinates[i], cells[i], i };
         }
+
+        std::sort( points.begin( ), points.end( ), []( const CellPoint& a, const CellPoint& b )
+        {
+            return a.cell < b.cell;
+        } );
+
+        return points;
     }
 
-    return shapeFunctionValues;
+    std::vector<size_t> offsets( numberOfCells + 1, 0 );
+
+    for( size_t cell : cells )
+    {
+        offsets[cell + 1] += 1;
+    }
+
+    std::partial_sum( offsets.begin( ), offsets.end( ), offsets.begin( ) );
+
+    for( size_t i = 0; i < numberOfPoints; ++i )
+    {
+        points[offsets[cells[i]]++] = { rCoordinates[i], sCoordinates[i], cells[i], i };
+    }
+
+    return points;
 }
 
-double computeComponent( const std::vector<double>& Nr,
-                         const std::vector<double>& Ns,
-                         const linalg::Matrix& controlPointValues )
+void evaluateSurfaceAtPoints( const std::array<KnotVector, 2>& knotVectors,
+                              const VectorOfMatrices& controlPoints,
+                              const double* rCoordinates,
+                              const double* sCoordinates,
+                              size_t numberOfPoints,
+                              const std::vector<double*>& results )
 {
-    size_t size1 = controlPointValues.size1( );
-    size_t size2 = controlPointValues.size2( );
+    SPLINEKERNEL_TIME_SCOPE( "evaluateSurfaceAtPoints", numberOfPoints );
+
+    size_t p = knotVectors[0].polynomialDegree( );
+    size_t q = knotVectors[1].polynomialDegree( );
+
+    // Knot span cells [t_i, t_i+1) x [t_j, t_j+1) are numbered by ( i - p ) * numberOfCellsS + j - q
+    size_t numberOfCellsS = knotVectors[1].numberOfControlPoints( ) - q;
+    size_t numberOfCells = ( knotVectors[0].numberOfControlPoints( ) - p ) * numberOfCellsS;
 
-    double value = 0.0;
+    std::vector<size_t> cells( numberOfPoints );
 
-    // Compute sum over basis functions (tensor product) times control point value
-    for( size_t iCP = 0; iCP < size1; ++iCP )
+    parallelFor( 0, numberOfPoints, pointGrainSize, [&]( size_t chunkBegin, size_t chunkEnd )
     {
-        for( size_t jCP = 0; jCP < size2; ++jCP )
+        SPLINEKERNEL_TIME_SCOPE( "surface points/knot span search", chunkEnd - chunkBegin );
+
+        for( size_t i = chunkBegin; i < chunkEnd; ++i )
         {
-            value += Nr[iCP] * Ns[jCP] * controlPointValues( iCP, jCP );
+            size_t spanR = knotVectors[0].findKnotSpan( rCoordinates[i] );
+            size_t spanS = knotVectors[1].findKnotSpan( sCoordinates[i] );
+
+            // Unclamped knot vectors extend beyond the range [t_p, t_n] in which the surface is defined
+            if( spanR < p || spanR >= knotVectors[0].numberOfControlPoints( ) ||
+                spanS < q || spanS >= knotVectors[1].numberOfControlPoints( ) )
+            {
+                throw std::out_of_range( "Point ( " + std::to_string( rCoordinates[i] ) + ", " +
+                                         std::to_string( sCoordinates[i] ) + " ) is outside of the surface." );
+            }
+
+            cells[i] = ( spanR - p ) * numberOfCellsS + spanS - q;
         }
+    } );
+
+    std::vector<CellPoint> points;
+
+    {
+        SPLINEKERNEL_TIME_SCOPE( "surface points/bucketing", numberOfPoints );
+
+        points = sortByCell( rCoordinates, sCoordinates, cells, numberOfCells );
     }
 
-    return value;
+    size_t numberOfComponents = controlPoints.size( );
+    size_t cellSize = ( p + 1 ) * ( q + 1 );
+
+    // Points in the same cell are consecutive. The ( p + 1 ) x ( q + 1 ) control points of the
+    // current cell are copied into a small contiguous block that stays in cache for all of them.
+    parallelFor( 0, numberOfPoints, pointGrainSize, [&]( size_t chunkBegin, size_t chunkEnd )
+    {
+        SPLINEKERNEL_TIME_SCOPE( "surface points/evaluation", chunkEnd - chunkBegin );
+
+        std::vector<double> cellControlPoints( numberOfComponents * cellSize );
+        std::vector<double> Nr( p + 1 ), Ns( q + 1 );
+
+        size_t currentCell = numberOfCells;
+        size_t spanR = 0, spanS = 0;
+
+        for( size_t k = chunkBegin; k < chunkEnd; ++k )
+        {
+            const CellPoint& point = points[k];
+
+            if( point.cell != currentCell )
+            {
+                currentCell = point.cell;
+
+                spanR = currentCell / numberOfCellsS + p;
+                spanS = currentCell % numberOfCellsS + q;
+
+                for( size_t iComponent = 0; iComponent < numberOfComponents; ++iComponent )
+                {
+                    double* target = &cellControlPoints[iComponent * cellSize];
+
+                    for( size_t a = 0; a <= p; ++a )
+                    {
+                        for( size_t b = 0; b <= q; ++b )
+                        {
+                            target[a * ( q + 1 ) + b] = controlPoints[iComponent]( spanR - p + a, spanS - q + b );
+                        }
+                    }
+                }
+            }
+
+            knotVectors[0].uniform( ).evaluateNonzeroBasis( point.r, spanR, Nr.data( ) );
+            knotVectors[1].uniform( ).evaluateNonzeroBasis( point.s, spanS, Ns.data( ) );
+
+            for( size_t iComponent = 0; iComponent < numberOfComponents; ++iComponent )
+            {
+                const double* values = &cellControlPoints[iComponent * cellSize];
+
+                double value = 0.0;
+
+                for( size_t a = 0; a <= p; ++a )
+                {
+                    double contractedS = 0.0;
+
+                    for( size_t b = 0; b <= q; ++b )
+                    {
+                        contractedS += Ns[b] * values[a * ( q + 1 ) + b];
+                    }
+
+                    value += Nr[a] * contractedS;
+                }
+
+                results[iComponent][point.index] = value;
+            }
+        }
+    } );
 }
 
-} // splinesurfacehelper
+} // namespace detail
 
 VectorOfMatrices evaluateSurface( const std::array<std::vector<double>, 2>& knotVectors,
                                   const VectorOfMatrices& controlPoints,
                                   std::array<size_t, 2> numberOfSamplePoints )
 {
-    using Shapes1D = std::vector<std::vector<double>>;
-
     // First evaluate shape functions separately in both coordinate directions
-    Shapes1D shapesR = detail::evaluateShapeFunctions( knotVectors[0], controlPoints[0].size1( ), numberOfSamplePoints[0] );
-    Shapes1D shapesS = detail::evaluateShapeFunctions( knotVectors[1], controlPoints[0].size2( ), numberOfSamplePoints[1] );
+    std::array<EvaluationPlan, 2> plans
+    {
+        EvaluationPlan( detail::uniformSamplePoints( numberOfSamplePoints[0] ), controlPoints[0].size1( ), knotVectors[0] ),
+        EvaluationPlan( detail::uniformSamplePoints( numberOfSamplePoints[1] ), controlPoints[0].size2( ), knotVectors[1] )
+    };
+
+    return evaluateSurface( plans, controlPoints );
+}
+
+VectorOfMatrices evaluateSurface( const std::array<EvaluationPlan, 2>& plans,
+                                  const VectorOfMatrices& controlPoints )
+{
+    size_t numberOfSamplesR = plans[0].numberOfSamples( );
+    size_t numberOfSamplesS = plans[1].numberOfSamples( );
+
+    size_t numberOfControlPointsS = plans[1].numberOfControlPoints( );
+
+    SPLINEKERNEL_TIME_SCOPE( "evaluateSurface", numberOfSamplesR * numberOfSamplesS );
+
+    detail::ContractionR contractInR = detail::selectContractionR( plans[0].polynomialDegree( ) );
+    detail::ContractionS contractInS = detail::selectContractionS( plans[1].polynomialDegree( ) );
 
     VectorOfMatrices result( controlPoints.size( ) );
 
     // Loop over components, e.g. x, y and z, each being a 2D matrix of values
     for( size_t iComponent = 0; iComponent < controlPoints.size( ); ++iComponent )
     {
-        result[iComponent] = linalg::Matrix( numberOfSamplePoints[0], numberOfSamplePoints[1], 0.0 );
+        if( controlPoints[iComponent].size1( ) != plans[0].numberOfControlPoints( ) ||
+            controlPoints[iComponent].size2( ) != numberOfControlPointsS )
+        {
+            throw std::runtime_error( "Inconsistent size in evaluateSurface." );
+        }
+
+        result[iComponent] = linalg::Matrix( numberOfSamplesR, numberOfSamplesS, 0.0 );
+    }
+
+    // Rows of samples in r are independent, so chunks of rows are evaluated in parallel
+    size_t grainSize = 1 + 4096 / ( numberOfSamplesS + 1 );
+
+    parallelFor( 0, numberOfSamplesR, grainSize, [&]( size_t chunkBegin, size_t chunkEnd )
+    {
+        SPLINEKERNEL_TIME_SCOPE( "surface/contraction", ( chunkEnd - chunkBegin ) * numberOfSamplesS );
+
+        // Control point values contracted in r-direction for one sample in r
+        std::vector<double> contractedR( numberOfControlPointsS );
+
+        for( size_t iComponent = 0; iComponent < controlPoints.size( ); ++iComponent )
+        {
+            const linalg::Matrix& controlPointValues = controlPoints[iComponent];
+
+            for( size_t iR = chunkBegin; iR < chunkEnd; ++iR )
+            {
+                // First sum over the p + 1 nonzero basis functions in r-direction, then over the
+                // q + 1 nonzero basis functions in s-direction for all samples in s
+                contractInR( plans[0], iR, controlPointValues, contractedR );
+                contractInS( plans[1], contractedR, iR, result[iComponent] );
+            }
+        }
+    } );
+
+    return result;
+}
+
+SurfaceDerivatives evaluateSurfaceDerivatives( const std::array<std::vector<double>, 2>& knotVectors,
+                                               const VectorOfMatrices& controlPoints,
+                                               std::array<size_t, 2> numberOfSamplePoints )
+{
+    if( controlPoints.empty( ) )
+    {
+        throw std::runtime_error( "Inconsistent size in evaluateSurfaceDerivatives." );
+    }
+
+    std::array<EvaluationPlan, 2> plans
+    {
+        EvaluationPlan( detail::uniformSamplePoints( numberOfSamplePoints[0] ), controlPoints[0].size1( ), knotVectors[0], 1 ),
+        EvaluationPlan( detail::uniformSamplePoints( numberOfSamplePoints[1] ), controlPoints[0].size2( ), knotVectors[1], 1 )
+    };
+
+    return evaluateSurfaceDerivatives( plans, controlPoints );
+}
+
+SurfaceDerivatives evaluateSurfaceDerivatives( const std::array<EvaluationPlan, 2>& plans,
+                                               const VectorOfMatrices& controlPoints )
+{
+    if( plans[0].numberOfDerivatives( ) == 0 || plans[1].numberOfDerivatives( ) == 0 )
+    {
+        throw std::runtime_error( "evaluateSurfaceDerivatives needs evaluation plans with first derivatives." );
+    }
+
+    size_t numberOfSamplesR = plans[0].numberOfSamples( );
+    size_t numberOfSamplesS = plans[1].numberOfSamples( );
+
+    size_t numberOfControlPointsS = plans[1].numberOfControlPoints( );
+    size_t numberOfComponents = controlPoints.size( );
+
+    size_t sizeR = plans[0].polynomialDegree( ) + 1;
+    size_t sizeS = plans[1].polynomialDegree( ) + 1;
+
+    SPLINEKERNEL_TIME_SCOPE( "evaluateSurfaceDerivatives", numberOfSamplesR * numberOfSamplesS );
+
+    SurfaceDerivatives result;
+
+    for( size_t iComponent = 0; iComponent < numberOfComponents; ++iComponent )
+    {
+        if( controlPoints[iComponent].size1( ) != plans[0].numberOfControlPoints( ) ||
+            controlPoints[iComponent].size2( ) != numberOfControlPointsS )
+        {
+            throw std::runtime_error( "Inconsistent size in evaluateSurfaceDerivatives." );
+        }
+
+        result.values.emplace_back( numberOfSamplesR, numberOfSamplesS, 0.0 );
+        result.derivativesR.emplace_back( numberOfSamplesR, numberOfSamplesS, 0.0 );
+        result.derivativesS.emplace_back( numberOfSamplesR, numberOfSamplesS, 0.0 );
+    }
+
+    bool computeNormals = numberOfComponents == 3;
+
+    if( computeNormals )
+    {
+        result.normals.assign( 3, linalg::Matrix( numberOfSamplesR, numberOfSamplesS, 0.0 ) );
+    }
+
+    size_t grainSize = 1 + 4096 / ( numberOfSamplesS + 1 );
 
-        // Loop over all sample points in local coordinates r and s
-        for( size_t iR = 0; iR < numberOfSamplePoints[0]; ++iR )
+    // Same sum factorization as in evaluateSurface, but with the basis function derivatives in
+    // addition to the values. All components of a row of samples are computed before the next row,
+    // so the normals are computed while the derivatives of the row are still in cache.
+    parallelFor( 0, numberOfSamplesR, grainSize, [&]( size_t chunkBegin, size_t chunkEnd )
+    {
+        std::vector<double> contractedR( numberOfControlPointsS );
+        std::vector<double> contractedDR( numberOfControlPointsS );
+
+        for( size_t iR = chunkBegin; iR < chunkEnd; ++iR )
         {
-            for( size_t iS = 0; iS < numberOfSamplePoints[1]; ++iS )
+            const double* Nr = plans[0].basisValues( iR );
+            const double* dNr = plans[0].basisDerivatives( iR, 1 );
+            size_t offsetR = plans[0].firstControlPoint( iR );
+
+            for( size_t iComponent = 0; iComponent < numberOfComponents; ++iComponent )
+            {
+                const linalg::Matrix& controlPointValues = controlPoints[iComponent];
+
+                std::fill( contractedR.begin( ), contractedR.end( ), 0.0 );
+                std::fill( contractedDR.begin( ), contractedDR.end( ), 0.0 );
+
+                for( size_t iCP = 0; iCP < sizeR; ++iCP )
+                {
+                    for( size_t jCP = 0; jCP < numberOfControlPointsS; ++jCP )
+                    {
+                        double value = controlPointValues( offsetR + iCP, jCP );
+
+                        contractedR[jCP] += Nr[iCP] * value;
+                        contractedDR[jCP] += dNr[iCP] * value;
+                    }
+                }
+
+                for( size_t iS = 0; iS < numberOfSamplesS; ++iS )
+                {
+                    const double* Ns = plans[1].basisValues( iS );
+                    const double* dNs = plans[1].basisDerivatives( iS, 1 );
+                    size_t offsetS = plans[1].firstControlPoint( iS );
+
+                    double value = 0.0, derivativeR = 0.0, derivativeS = 0.0;
+
+                    for( size_t jCP = 0; jCP < sizeS; ++jCP )
+                    {
+                        value += Ns[jCP] * contractedR[offsetS + jCP];
+                        derivativeR += Ns[jCP] * contractedDR[offsetS + jCP];
+                        derivativeS += dNs[jCP] * contractedR[offsetS + jCP];
+                    }
+
+                    result.values[iComponent]( iR, iS ) = value;
+                    result.derivativesR[iComponent]( iR, iS ) = derivativeR;
+                    result.derivativesS[iComponent]( iR, iS ) = derivativeS;
+                }
+            }
+
+            if( computeNormals )
             {
-                // Compute tensor product and multiply by control point values
-                result[iComponent]( iR, iS ) = detail::computeComponent( shapesR[iR], shapesS[iS], controlPoints[iComponent] );
+                const VectorOfMatrices& Sr = result.derivativesR;
+                const VectorOfMatrices& Ss = result.derivativesS;
+
+                for( size_t iS = 0; iS < numberOfSamplesS; ++iS )
+                {
+                    double normal[3];
+
+                    for( size_t i = 0; i < 3; ++i )
+                    {
+                        size_t j = ( i + 1 ) % 3;
+                        size_t k = ( i + 2 ) % 3;
+
+                        normal[i] = Sr[j]( iR, iS ) * Ss[k]( iR, iS ) - Sr[k]( iR, iS ) * Ss[j]( iR, iS );
+                    }
+
+                    double length = std::sqrt( normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2] );
+
+                    // Degenerate points, e.g. at collapsed edges, keep a zero normal
+                    double scaling = length > 0.0 ? 1.0 / length : 0.0;
+
+                    for( size_t i = 0; i < 3; ++i )
+                    {
+                        result.normals[i]( iR, iS ) = scaling * normal[i];
+                    }
+                }
             }
         }
+    } );
+
+    return result;
+}
+
+std::vector<std::vector<double>> evaluateSurfaceAtPoints( const std::array<std::vector<double>, 2>& knotVectors,
+                                                          const VectorOfMatrices& controlPoints,
+                                                          const std::vector<double>& rCoordinates,
+                                                          const std::vector<double>& sCoordinates )
+{
+    if( controlPoints.empty( ) || rCoordinates.size( ) != sCoordinates.size( ) )
+    {
+        throw std::runtime_error( "Inconsistent size in evaluateSurfaceAtPoints." );
+    }
+
+    std::array<KnotVector, 2> validatedKnotVectors
+    {
+        KnotVector( controlPoints[0].size1( ), knotVectors[0] ),
+        KnotVector( controlPoints[0].size2( ), knotVectors[1] )
+    };
+
+    for( const auto& component : controlPoints )
+    {
+        if( component.size1( ) != controlPoints[0].size1( ) || component.size2( ) != controlPoints[0].size2( ) )
+        {
+            throw std::runtime_error( "Inconsistent size in evaluateSurfaceAtPoints." );
+        }
     }
 
+    size_t numberOfPoints = rCoordinates.size( );
+
+    std::vector<std::vector<double>> result( controlPoints.size( ), std::vector<double>( numberOfPoints ) );
+    std::vector<double*> targets;
+
+    for( auto& component : result )
+    {
+        targets.push_back( component.data( ) );
+    }
+
+    detail::evaluateSurfaceAtPoints( validatedKnotVectors, controlPoints, rCoordinates.data( ),
+                                     sCoordinates.data( ), numberOfPoints, targets );
+
     return result;
 }
 
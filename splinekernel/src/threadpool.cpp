@@ -0,0 +1,248 @@
+#include "threadpool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace detail
+{
+
+// Shared between the threads working on one parallel loop. Threads that start after all chunks
+// were claimed return without accessing the function, which may then be out of scope already.
+struct ParallelForState
+{
+    size_t begin;
+    size_t end;
+    size_t chunkSize;
+    size_t numberOfChunks;
+
+    const std::function<void( size_t, size_t )>* function;
+
+    std::atomic<size_t> nextChunk;
+    std::atomic<size_t> finishedChunks;
+    std::atomic<bool> failed;
+
+    std::exception_ptr exception;
+
+    std::mutex mutex;
+    std::condition_variable finished;
+};
+
+void runChunks( ParallelForState& state )
+{
+    for( size_t iChunk = state.nextChunk++; iChunk < state.numberOfChunks; iChunk = state.nextChunk++ )
+    {
+        // Skip the remaining chunks after an exception
+        if( !state.failed )
+        {
+            size_t chunkBegin = state.begin + iChunk * state.chunkSize;
+            size_t chunkEnd = std::min( chunkBegin + state.chunkSize, state.end );
+
+            try
+            {
+                ( *state.function )( chunkBegin, chunkEnd );
+            }
+            catch( ... )
+            {
+                std::lock_guard<std::mutex> lock( state.mutex );
+
+                if( !state.failed.exchange( true ) )
+                {
+                    state.exception = std::current_exception( );
+                }
+            }
+        }
+
+        if( ++state.finishedChunks == state.numberOfChunks )
+        {
+            std::lock_guard<std::mutex> lock( state.mutex );
+
+            state.finished.notify_all( );
+        }
+    }
+}
+
+size_t hardwareThreads( )
+{
+    return std::max( std::thread::hardware_concurrency( ), 1u );
+}
+
+std::atomic<size_t>& numberOfThreads( )
+{
+    static std::atomic<size_t> numberOfThreads( hardwareThreads( ) );
+
+    return numberOfThreads;
+}
+
+} // namespace detail
+
+ThreadPool::ThreadPool( size_t numberOfThreads ) :
+    m_stop( false )
+{
+    reserve( numberOfThreads );
+}
+
+ThreadPool::~ThreadPool( )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        m_stop = true;
+    }
+
+    m_condition.notify_all( );
+
+    for( std::thread& worker : m_workers )
+    {
+        worker.join( );
+    }
+}
+
+size_t ThreadPool::numberOfThreads( ) const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_workers.size( ) + 1;
+}
+
+void ThreadPool::reserve( size_t numberOfThreads )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    while( m_workers.size( ) + 1 < numberOfThreads )
+    {
+        m_workers.emplace_back( &ThreadPool::work, this );
+    }
+}
+
+void ThreadPool::enqueue( std::function<void( )> task )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        m_tasks.push_back( std::move( task ) );
+    }
+
+    m_condition.notify_one( );
+}
+
+void ThreadPool::work( )
+{
+    while( true )
+    {
+        std::function<void( )> task;
+
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+
+            m_condition.wait( lock, [this]( ) { return m_stop || !m_tasks.empty( ); } );
+
+            if( m_stop && m_tasks.empty( ) )
+            {
+                return;
+            }
+
+            task = std::move( m_tasks.front( ) );
+            m_tasks.pop_front( );
+        }
+
+        task( );
+    }
+}
+
+void ThreadPool::parallelFor( size_t begin,
+                              size_t end,
+                              size_t grainSize,
+                              const std::function<void( size_t, size_t )>& function,
+                              size_t numberOfThreads )
+{
+    if( begin >= end )
+    {
+        return;
+    }
+
+    size_t size = end - begin;
+    size_t availableThreads = this->numberOfThreads( );
+
+    numberOfThreads = numberOfThreads == 0 ? availableThreads : std::min( numberOfThreads, availableThreads );
+
+    // A few chunks per thread for load balancing, but not less than grainSize indices each
+    size_t chunkSize = std::max( std::max( grainSize, size_t { 1 } ), ( size + 4 * numberOfThreads - 1 ) / ( 4 * numberOfThreads ) );
+    size_t numberOfChunks = ( size + chunkSize - 1 ) / chunkSize;
+
+    if( numberOfThreads == 1 || numberOfChunks == 1 )
+    {
+        function( begin, end );
+
+        return;
+    }
+
+    auto state = std::make_shared<detail::ParallelForState>( );
+
+    state->begin = begin;
+    state->end = end;
+    state->chunkSize = chunkSize;
+    state->numberOfChunks = numberOfChunks;
+    state->function = &function;
+    state->nextChunk = 0;
+    state->finishedChunks = 0;
+    state->failed = false;
+
+    size_t numberOfHelpers = std::min( numberOfThreads, numberOfChunks ) - 1;
+
+    for( size_t iHelper = 0; iHelper < numberOfHelpers; ++iHelper )
+    {
+        enqueue( [state]( ) { detail::runChunks( *state ); } );
+    }
+
+    // The calling thread works as well and then waits for the chunks claimed by the helpers
+    detail::runChunks( *state );
+
+    {
+        std::unique_lock<std::mutex> lock( state->mutex );
+
+        state->finished.wait( lock, [&state]( ) { return state->finishedChunks == state->numberOfChunks; } );
+    }
+
+    if( state->exception )
+    {
+        std::rethrow_exception( state->exception );
+    }
+}
+
+ThreadPool& globalThreadPool( )
+{
+    static ThreadPool pool( getNumberOfThreads( ) );
+
+    return pool;
+}
+
+void setNumberOfThreads( size_t numberOfThreads )
+{
+    numberOfThreads = numberOfThreads == 0 ? detail::hardwareThreads( ) : numberOfThreads;
+
+    detail::numberOfThreads( ) = numberOfThreads;
+
+    globalThreadPool( ).reserve( numberOfThreads );
+}
+
+size_t getNumberOfThreads( )
+{
+    return detail::numberOfThreads( );
+}
+
+void parallelFor( size_t begin,
+                  size_t end,
+                  size_t grainSize,
+                  const std::function<void( size_t, size_t )>& function )
+{
+    globalThreadPool( ).parallelFor( begin, end, grainSize, function, getNumberOfThreads( ) );
+}
+
+} // namespace splinekernel
+} // namespace cie
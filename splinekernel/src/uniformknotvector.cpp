@@ -0,0 +1,213 @@
+#include "uniformknotvector.hpp"
+#include "basisfunctions.hpp"
+#include "curve.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace detail
+{
+
+/*! Runs the Cox-de Boor recurrence on polynomials in u for the knots t_{s + i} = i, i.e. for the
+ *  span [0, 1] of a uniform knot vector with unit knot distance. There the left and right
+ *  differences are u + j - r - 1 and r + 1 - u and their sum is j. The result holds the
+ *  coefficients of the p + 1 nonzero basis functions in rows, with increasing powers of u.
+ */
+std::vector<double> uniformBasisMatrix( size_t p )
+{
+    size_t size = p + 1;
+
+    std::vector<double> N( size * size, 0.0 );
+    std::vector<double> saved( size ), temp( size );
+
+    N[0] = 1.0;
+
+    for( size_t j = 1; j < size; ++j )
+    {
+        std::fill( saved.begin( ), saved.end( ), 0.0 );
+
+        for( size_t r = 0; r < j; ++r )
+        {
+            double* Nr = &N[r * size];
+
+            for( size_t k = 0; k < size; ++k )
+            {
+                temp[k] = Nr[k] / j;
+            }
+
+            // N_r = saved + ( r + 1 - u ) * temp and saved = ( u + j - r - 1 ) * temp
+            for( size_t k = 0; k < size; ++k )
+            {
+                double shifted = k > 0 ? temp[k - 1] : 0.0;
+
+                Nr[k] = saved[k] + ( r + 1.0 ) * temp[k] - shifted;
+                saved[k] = ( j - r - 1.0 ) * temp[k] + shifted;
+            }
+        }
+
+        std::copy( saved.begin( ), saved.end( ), N.begin( ) + j * size );
+    }
+
+    return N;
+}
+
+} // namespace detail
+
+UniformKnotVector::UniformKnotVector( size_t numberOfControlPoints,
+                                      const std::vector<double>& knotVector,
+                                      double tolerance ) :
+    m_knotVector( knotVector ),
+    m_numberOfControlPoints( numberOfControlPoints ),
+    m_knotDistance( 0.0 ),
+    m_firstUniformKnot( 1 ),
+    m_lastUniformKnot( 0 )
+{
+    size_t n = numberOfControlPoints;
+    size_t m = knotVector.size( );
+
+    if( m < n + 1 )
+    {
+        throw std::runtime_error( "Inconsistent size in UniformKnotVector." );
+    }
+
+    size_t p = m - n - 1;
+
+    m_polynomialDegree = p;
+    m_basisMatrix = detail::uniformBasisMatrix( p );
+
+    if( n <= p )
+    {
+        return;
+    }
+
+    double h = ( knotVector[n] - knotVector[p] ) / ( n - p );
+
+    auto equidistant = [&]( size_t i )
+    {
+        return std::abs( knotVector[i + 1] - knotVector[i] - h ) <= tolerance * h;
+    };
+
+    if( !( h > 0.0 ) )
+    {
+        return;
+    }
+
+    for( size_t i = p; i < n; ++i )
+    {
+        if( !equidistant( i ) )
+        {
+            return;
+        }
+    }
+
+    m_knotDistance = h;
+    m_firstUniformKnot = p;
+    m_lastUniformKnot = n;
+
+    // Unclamped knot vectors may continue uniformly beyond the nonzero spans
+    while( m_firstUniformKnot > 0 && equidistant( m_firstUniformKnot - 1 ) )
+    {
+        --m_firstUniformKnot;
+    }
+
+    while( m_lastUniformKnot + 1 < m && equidistant( m_lastUniformKnot ) )
+    {
+        ++m_lastUniformKnot;
+    }
+}
+
+bool UniformKnotVector::isUniform( ) const
+{
+    return m_knotDistance > 0.0;
+}
+
+double UniformKnotVector::knotDistance( ) const
+{
+    return m_knotDistance;
+}
+
+size_t UniformKnotVector::polynomialDegree( ) const
+{
+    return m_polynomialDegree;
+}
+
+size_t UniformKnotVector::findKnotSpan( double t ) const
+{
+    size_t n = m_numberOfControlPoints;
+    size_t p = m_polynomialDegree;
+
+    double first = m_knotVector[p];
+    double last = m_knotVector[n];
+
+    // Also handles coordinates outside of the knot vector, before t_p or after t_n and NaN
+    if( !isUniform( ) || !std::isfinite( t ) || t < first || t >= last - 1e-10 )
+    {
+        return detail::searchKnotSpan( t, n, m_knotVector );
+    }
+
+    size_t knotSpanIndex = p + std::min( static_cast<size_t>( ( t - first ) / m_knotDistance ), n - p - 1 );
+
+    // Correct rounding errors of the division
+    while( t < m_knotVector[knotSpanIndex] )
+    {
+        --knotSpanIndex;
+    }
+
+    while( t >= m_knotVector[knotSpanIndex + 1] )
+    {
+        ++knotSpanIndex;
+    }
+
+    return knotSpanIndex;
+}
+
+bool UniformKnotVector::hasUniformBasis( size_t knotSpanIndex ) const
+{
+    // The basis functions in span s depend on the knots t_{s - p + 1} to t_{s + p}
+    return knotSpanIndex + 1 >= m_firstUniformKnot + m_polynomialDegree &&
+           knotSpanIndex + m_polynomialDegree <= m_lastUniformKnot;
+}
+
+const std::vector<double>& UniformKnotVector::basisMatrix( ) const
+{
+    return m_basisMatrix;
+}
+
+void UniformKnotVector::evaluateNonzeroBasis( double t,
+                                              size_t knotSpanIndex,
+                                              double* basisValues ) const
+{
+    size_t p = m_polynomialDegree;
+
+    if( !hasUniformBasis( knotSpanIndex ) )
+    {
+        evaluateNonzeroBSplineBasis( t, knotSpanIndex, p, m_knotVector, basisValues );
+
+        return;
+    }
+
+    double u = ( t - m_knotVector[knotSpanIndex] ) / m_knotDistance;
+
+    // Horner's scheme for each row of the basis matrix
+    for( size_t j = 0; j < p + 1; ++j )
+    {
+        const double* coefficients = &m_basisMatrix[j * ( p + 1 )];
+
+        double value = coefficients[p];
+
+        for( size_t k = p; k > 0; --k )
+        {
+            value = value * u + coefficients[k - 1];
+        }
+
+        basisValues[j] = value;
+    }
+}
+
+} // namespace splinekernel
+} // namespace cie
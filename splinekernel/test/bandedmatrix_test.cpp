@@ -0,0 +1,129 @@
+#include "catch.hpp"
+#include "bandedmatrix.hpp"
+
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+TEST_CASE( "BandedMatrix_test" )
+{
+    // Matrix with one lower and two upper diagonals:
+    // | 4  1  1  0  0 |
+    // | 1  4  1  1  0 |
+    // | 0  1  4  1  1 |
+    // | 0  0  1  4  1 |
+    // | 0  0  0  1  4 |
+    BandedMatrix A( 5, 1, 2 );
+
+    REQUIRE( A.size( ) == 5 );
+    REQUIRE( A.lowerBandwidth( ) == 1 );
+    REQUIRE( A.upperBandwidth( ) == 2 );
+
+    for( size_t i = 0; i < 5; ++i )
+    {
+        A( i, i ) = 4.0;
+
+        if( i > 0 ) A( i, i - 1 ) = 1.0;
+        if( i + 1 < 5 ) A( i, i + 1 ) = 1.0;
+        if( i + 2 < 5 ) A( i, i + 2 ) = 1.0;
+    }
+
+    CHECK( A( 2, 1 ) == 1.0 );
+    CHECK( A( 2, 4 ) == 1.0 );
+
+    // Solving before factorizing is an error
+    CHECK_THROWS( A.solve( std::vector<double>( 5, 1.0 ) ) );
+
+    REQUIRE_NOTHROW( A.factorize( ) );
+
+    // Right hand side for the solution x = ( 1, 2, 3, 4, 5 )
+    std::vector<double> b{ 9.0, 16.0, 23.0, 24.0, 24.0 };
+    std::vector<double> x;
+
+    REQUIRE_NOTHROW( x = A.solve( b ) );
+
+    REQUIRE( x.size( ) == 5 );
+
+    for( size_t i = 0; i < 5; ++i )
+    {
+        CHECK( x[i] == Approx( i + 1.0 ) );
+    }
+
+    // Multiple right hand sides stored row-major, the second solution is x = ( 1, 1, 1, 1, 1 )
+    std::vector<double> B{ 9.0, 6.0, 16.0, 7.0, 23.0, 7.0, 24.0, 6.0, 24.0, 5.0 };
+
+    REQUIRE_NOTHROW( A.solve( B.data( ), 2 ) );
+
+    for( size_t i = 0; i < 5; ++i )
+    {
+        CHECK( B[2 * i] == Approx( i + 1.0 ) );
+        CHECK( B[2 * i + 1] == Approx( 1.0 ) );
+    }
+
+    CHECK_THROWS( A.solve( std::vector<double>( 4, 1.0 ) ) );
+
+    // The pivot tolerance is relative, so a tiny but regular matrix factorizes and a singular one does not
+    BandedMatrix scaled( 2, 1, 1 ), singular( 2, 1, 1 );
+
+    scaled( 0, 0 ) = 2e-15;
+    scaled( 0, 1 ) = 1e-15;
+    scaled( 1, 0 ) = 1e-15;
+    scaled( 1, 1 ) = 2e-15;
+
+    REQUIRE_NOTHROW( scaled.factorize( ) );
+
+    x = scaled.solve( { 3e-15, 3e-15 } );
+
+    CHECK( x[0] == Approx( 1.0 ) );
+    CHECK( x[1] == Approx( 1.0 ) );
+
+    singular( 0, 0 ) = 1e3;
+    singular( 0, 1 ) = 2e3;
+    singular( 1, 0 ) = 2e3;
+    singular( 1, 1 ) = 4e3;
+
+    CHECK_THROWS( singular.factorize( ) );
+}
+
+TEST_CASE( "BandedMatrixRefactorization_test" )
+{
+    BandedMatrix A( 4, 1, 1 );
+
+    for( size_t i = 0; i < 4; ++i )
+    {
+        A( i, i ) = 2.0;
+
+        if( i > 0 ) A( i, i - 1 ) = -1.0;
+        if( i + 1 < 4 ) A( i, i + 1 ) = -1.0;
+    }
+
+    REQUIRE_NOTHROW( A.factorize( ) );
+
+    // Replace the last row by ( 0, 0, -1, 1 ) and only refactorize this row
+    A( 3, 2 ) = -1.0;
+    A( 3, 3 ) = 1.0;
+
+    REQUIRE_NOTHROW( A.factorize( 3 ) );
+
+    // Solution x = ( 1, 2, 3, 4 )
+    std::vector<double> x = A.solve( { 0.0, 0.0, 0.0, 1.0 } );
+
+    for( size_t i = 0; i < 4; ++i )
+    {
+        CHECK( x[i] == Approx( i + 1.0 ) );
+    }
+
+    // Singular matrix
+    BandedMatrix B( 3, 1, 1 );
+
+    B( 0, 0 ) = 1.0;
+    B( 1, 0 ) = 1.0;
+
+    CHECK_THROWS( B.factorize( ) );
+}
+
+} // namespace splinekernel
+} // namespace cie
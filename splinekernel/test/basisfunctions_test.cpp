@@ -1,5 +1,6 @@
 #include "catch.hpp"
 #include "basisfunctions.hpp" 
+#include "curve.hpp"
 #include <vector>
 
 namespace cie
@@ -90,5 +91,105 @@ TEST_CASE("Quadratic C1 interpolation")
     CHECK_THROWS(evaluateBSplineBasis(0.0, 4, p, knotVector));
 }
 
+TEST_CASE("Nonzero basis functions")
+{
+    // Degrees 1 to 5 have specialized implementations, higher degrees use the generic one
+    for( size_t p = 1; p < 8; ++p )
+    {
+        std::vector<double> knotVector( p + 1, 0.0 );
+
+        knotVector.insert( knotVector.end( ), { 1.0, 4.0, 4.0 } );
+        knotVector.resize( knotVector.size( ) + p + 1, 9.0 );
+
+        const size_t n = knotVector.size( ) - p - 1;
+
+        std::vector<double> N( p + 1 );
+
+        for( double t : { 0.0, 0.5, 1.0, 2.5, 4.0, 6.0, 8.99, 9.0 } )
+        {
+            size_t span = findKnotSpan( t, n, knotVector );
+
+            REQUIRE_NOTHROW( evaluateNonzeroBSplineBasis( t, span, p, knotVector, N.data( ) ) );
+
+            double sum = 0.0;
+
+            // Must be identical to the recursive evaluation of the same functions
+            for( size_t i = 0; i <= p; ++i )
+            {
+                CHECK( N[i] == Approx( evaluateBSplineBasis( t, span - p + i, p, knotVector ) ) );
+
+                sum += N[i];
+            }
+
+            // Partition of unity
+            CHECK( sum == Approx( 1.0 ) );
+        }
+    }
+}
+
+TEST_CASE("Basis function derivatives")
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 1.0, 4.0, 4.0, 9.0, 9.0, 9.0, 9.0 };
+    std::vector<double> t{ 0.0, 0.5, 2.5, 4.0, 6.0, 9.0 };
+
+    const size_t p = 3;
+    const size_t numberOfDerivatives = 4;
+
+    BasisFunctionDerivatives result;
+
+    REQUIRE_NOTHROW( result = evaluateBSplineBasisDerivatives( t, p, numberOfDerivatives, knotVector ) );
+
+    REQUIRE( result.knotSpans.size( ) == t.size( ) );
+    REQUIRE( result.values.size( ) == t.size( ) * ( numberOfDerivatives + 1 ) * ( p + 1 ) );
+
+    // Function values must match the recursive evaluation
+    for( size_t iT = 0; iT < t.size( ); ++iT )
+    {
+        for( size_t i = 0; i <= p; ++i )
+        {
+            size_t index = result.knotSpans[iT] - p + i;
+
+            CHECK( result( iT, 0, i ) == Approx( evaluateBSplineBasis( t[iT], index, p, knotVector ) ) );
+            CHECK( result( iT, 4, i ) == 0.0 );
+        }
+    }
+
+    // Check derivatives in the interior of a span against central differences
+    double h = 1e-5;
+    double t0 = 2.5;
+
+    for( size_t i = 0; i <= p; ++i )
+    {
+        size_t index = result.knotSpans[2] - p + i;
+
+        double dN = ( evaluateBSplineBasis( t0 + h, index, p, knotVector ) -
+                      evaluateBSplineBasis( t0 - h, index, p, knotVector ) ) / ( 2.0 * h );
+
+        CHECK( result( 2, 1, i ) == Approx( dN ).epsilon( 1e-6 ) );
+    }
+
+    // Derivatives of the first basis function N_0 = ( 1 - t )^3 at t = 0
+    CHECK( result( 0, 0, 0 ) == Approx( 1.0 ) );
+    CHECK( result( 0, 1, 0 ) == Approx( -3.0 ) );
+    CHECK( result( 0, 2, 0 ) == Approx( 6.0 ) );
+    CHECK( result( 0, 3, 0 ) == Approx( -6.0 ) );
+
+    // Derivatives of all basis functions sum up to zero
+    for( size_t iT = 0; iT < t.size( ); ++iT )
+    {
+        for( size_t k = 1; k <= numberOfDerivatives; ++k )
+        {
+            double sum = 0.0;
+
+            for( size_t i = 0; i <= p; ++i )
+            {
+                sum += result( iT, k, i );
+            }
+
+            CHECK( sum == Approx( 0.0 ).margin( 1e-10 ) );
+        }
+    }
+}
+
 } // namespace splinekernel
 } // namespace cie
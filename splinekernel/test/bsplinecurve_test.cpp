@@ -0,0 +1,90 @@
+#include "catch.hpp"
+#include "bsplinecurve.hpp"
+#include "curve.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+TEST_CASE( "BSplineCurve_test" )
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 1.0, 4.0, 9.0, 9.0, 9.0, 9.0 };
+    std::vector<double> t{ 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0 };
+
+    std::vector<double> x{ 0.0, 10.0, 9.0, 4.5, 1.5, 1.0 };
+    std::vector<double> y{ 0.0,  1.0, 4.0, 7.5, 6.0, 1.0 };
+
+    BSplineCurve curve( x, y, knotVector );
+
+    REQUIRE( curve.numberOfControlPoints( ) == 6 );
+    REQUIRE( curve.polynomialDegree( ) == 3 );
+    REQUIRE( curve.knotVector( ).knots( ) == knotVector );
+
+    std::array<std::vector<double>, 2> expected = evaluate2DCurve( t, x, y, knotVector );
+    std::array<std::vector<double>, 2> C;
+
+    REQUIRE_NOTHROW( C = curve.evaluate( t ) );
+
+    REQUIRE( C[0].size( ) == t.size( ) );
+    REQUIRE( C[1].size( ) == t.size( ) );
+
+    for( size_t i = 0; i < t.size( ); ++i )
+    {
+        CHECK( C[0][i] == Approx( expected[0][i] ) );
+        CHECK( C[1][i] == Approx( expected[1][i] ) );
+
+        std::array<double, 2> point = curve.evaluate( t[i] );
+
+        CHECK( point[0] == Approx( expected[0][i] ) );
+        CHECK( point[1] == Approx( expected[1][i] ) );
+    }
+
+    // Streaming yields the same samples as evaluating all at once
+    std::vector<double> streamed( 2 * t.size( ) );
+
+    curve.stream( 0.0, 9.0, t.size( ), [&]( size_t firstSample, size_t size, const double*, const double* curveX, const double* curveY )
+    {
+        std::copy( curveX, curveX + size, &streamed[firstSample] );
+        std::copy( curveY, curveY + size, &streamed[t.size( ) + firstSample] );
+    }, 3 );
+
+    for( size_t i = 0; i < t.size( ); ++i )
+    {
+        CHECK( streamed[i] == Approx( expected[0][i] ) );
+        CHECK( streamed[t.size( ) + i] == Approx( expected[1][i] ) );
+    }
+
+    CHECK_THROWS( curve.evaluate( std::vector<double>{ 9.5 } ) );
+    CHECK_THROWS( curve.evaluate( -0.5 ) );
+
+    // Unclamped knot vector, where the curve is only defined within [t_p, t_n] = [0.3, 0.4]
+    BSplineCurve unclamped( { 1.0, 2.0, 3.0, 4.0 }, { 1.0, 1.0, 1.0, 1.0 }, { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7 } );
+
+    std::array<double, 2> P = unclamped.evaluate( 0.35 );
+
+    CHECK( P[0] == Approx( evaluate2DCurve( { 0.35 }, unclamped.xCoordinates( ), unclamped.yCoordinates( ),
+                                            unclamped.knotVector( ).knots( ) )[0][0] ) );
+
+    std::vector<double> outside{ 0.3, 0.35, 0.05 };
+    std::vector<double> curveX( outside.size( ) ), curveY( outside.size( ) );
+
+    CHECK_THROWS_AS( unclamped.evaluate( 0.05 ), std::out_of_range );
+    CHECK_THROWS_AS( unclamped.evaluate( 0.45 ), std::out_of_range );
+    CHECK_THROWS_AS( unclamped.evaluate( outside ), std::out_of_range );
+    CHECK_THROWS_AS( unclamped.evaluate( outside.data( ), outside.size( ), curveX.data( ), curveY.data( ) ), std::out_of_range );
+    CHECK_THROWS_AS( unclamped.stream( 0.0, 0.4, 5, []( size_t, size_t, const double*, const double*, const double* ) { } ), std::out_of_range );
+
+    // Inconsistent sizes
+    CHECK_THROWS( BSplineCurve( x, { 0.0, 1.0 }, knotVector ) );
+    CHECK_THROWS( BSplineCurve( { 0.0, 1.0 }, { 0.0, 1.0 }, knotVector ) );
+    CHECK_THROWS( BSplineCurve( x, y, curve.knotVector( ).breakpoints( ) ) );
+}
+
+} // namespace splinekernel
+} // namespace cie
@@ -0,0 +1,97 @@
+#include "catch.hpp"
+#include "bsplinesurface.hpp"
+
+#include <array>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+TEST_CASE( "BSplineSurface_test" )
+{
+    std::vector<double> knotVectorR{ 0.0, 0.0, 0.0, 1.0, 2.0, 2.0, 2.0 };
+    std::vector<double> knotVectorS{ 0.0, 0.0, 0.5, 1.0, 1.0 };
+
+    linalg::Matrix zGrid( { 1.0, 2.0, 0.5,
+                            3.0, 1.0, 1.0,
+                            0.0, 2.0, 4.0,
+                            1.0, 1.0, 2.0 }, 4 );
+
+    BSplineSurface surface( { knotVectorR, knotVectorS }, { zGrid } );
+
+    REQUIRE( surface.numberOfComponents( ) == 1 );
+    REQUIRE( surface.numberOfControlPoints( ) == ( std::array<size_t, 2>{ 4, 3 } ) );
+    REQUIRE( surface.polynomialDegrees( ) == ( std::array<size_t, 2>{ 2, 1 } ) );
+
+    std::vector<double> r{ 0.0, 0.5, 1.0, 1.5, 2.0 };
+    std::vector<double> s{ 0.0, 0.5, 1.0 };
+
+    std::array<EvaluationPlan, 2> plans{ EvaluationPlan( r, 4, knotVectorR ), EvaluationPlan( s, 3, knotVectorS ) };
+
+    VectorOfMatrices expected = evaluateSurface( plans, { zGrid } );
+
+    // The samples cover the parameter range [0, 2] x [0, 1] of the knot vectors
+    for( const VectorOfMatrices& C : { surface.evaluate( r, s ),
+                                       surface.evaluate( surface.createPlans( r, s ) ),
+                                       surface.evaluate( { 5, 3 } ) } )
+    {
+        REQUIRE( C.size( ) == 1 );
+        REQUIRE( C[0].size1( ) == r.size( ) );
+        REQUIRE( C[0].size2( ) == s.size( ) );
+
+        for( size_t iR = 0; iR < r.size( ); ++iR )
+        {
+            for( size_t iS = 0; iS < s.size( ); ++iS )
+            {
+                CHECK( C[0]( iR, iS ) == Approx( expected[0]( iR, iS ) ) );
+            }
+        }
+    }
+
+    SurfaceDerivatives derivatives = surface.evaluateDerivatives( r, s );
+    SurfaceDerivatives samples = surface.evaluateDerivatives( { 5, 3 } );
+
+    REQUIRE( derivatives.values.size( ) == 1 );
+    REQUIRE( derivatives.derivativesR.size( ) == 1 );
+    REQUIRE( derivatives.normals.empty( ) );
+
+    SurfaceDerivatives fromPlans = evaluateSurfaceDerivatives( surface.createPlans( r, s, 1 ), { zGrid } );
+
+    for( size_t iR = 0; iR < r.size( ); ++iR )
+    {
+        for( size_t iS = 0; iS < s.size( ); ++iS )
+        {
+            CHECK( derivatives.values[0]( iR, iS ) == Approx( expected[0]( iR, iS ) ) );
+            CHECK( derivatives.derivativesR[0]( iR, iS ) == Approx( fromPlans.derivativesR[0]( iR, iS ) ) );
+            CHECK( derivatives.derivativesS[0]( iR, iS ) == Approx( fromPlans.derivativesS[0]( iR, iS ) ) );
+            CHECK( samples.derivativesR[0]( iR, iS ) == Approx( fromPlans.derivativesR[0]( iR, iS ) ) );
+        }
+    }
+
+    CHECK_THROWS( surface.evaluateDerivatives( surface.createPlans( r, s ) ) );
+
+    std::vector<double> rPoints{ 1.5, 0.0, 2.0, 0.7 };
+    std::vector<double> sPoints{ 0.5, 1.0, 0.0, 0.2 };
+
+    std::vector<std::vector<double>> values = surface.evaluateAtPoints( rPoints, sPoints );
+
+    REQUIRE( values.size( ) == 1 );
+    REQUIRE( values[0].size( ) == rPoints.size( ) );
+
+    for( size_t i = 0; i < rPoints.size( ); ++i )
+    {
+        CHECK( values[0][i] == Approx( surface.evaluate( { rPoints[i] }, { sPoints[i] } )[0]( 0, 0 ) ) );
+    }
+
+    CHECK_THROWS( surface.evaluateAtPoints( rPoints, { 0.5 } ) );
+
+    // Grid of control points does not match the knot vectors
+    CHECK_THROWS( BSplineSurface( { knotVectorS, knotVectorR }, { zGrid } ) );
+    CHECK_THROWS( BSplineSurface( { knotVectorR, knotVectorS }, { zGrid, linalg::Matrix( 3, 3, 0.0 ) } ) );
+    CHECK_THROWS( BSplineSurface( { knotVectorR, knotVectorS }, { } ) );
+}
+
+} // namespace splinekernel
+} // namespace cie
@@ -1,7 +1,9 @@
 #include "catch.hpp"
 #include "curve.hpp"
 
+#include <algorithm>
 #include <array>
+#include <stdexcept>
 #include <vector>
 
 namespace cie
@@ -49,5 +51,276 @@ TEST_CASE("Linear interpolation curve")
     CHECK( C[1][10] == Approx( 3.0 ) );
 }
 
+TEST_CASE("Cubic curve")
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 1.0, 4.0, 9.0, 9.0, 9.0, 9.0 };
+    std::vector<double> x{ 0.0, 10.0, 9.0, 4.5, 1.5, 1.0 };
+    std::vector<double> y{ 0.0,  1.0, 4.0, 7.5, 6.0, 1.0 };
+    std::vector<double> t{ 0.0, 1.0, 4.0, 5.0, 9.0 };
+    std::array<std::vector<double>, 2> C;
+
+    REQUIRE_NOTHROW( C = evaluate2DCurve( t, x, y, knotVector ) );
+
+    REQUIRE( C[0].size( ) == t.size( ) );
+    REQUIRE( C[1].size( ) == t.size( ) );
+
+    CHECK( C[0][0] == Approx( 0.0 ) );
+    CHECK( C[0][1] == Approx( 9.4375 ) );
+    CHECK( C[0][2] == Approx( 5.6406 ) );
+    CHECK( C[0][3] == Approx( 4.336 ) );
+    CHECK( C[0][4] == Approx( 1.0 ) );
+
+    CHECK( C[1][0] == Approx( 0.0 ) );
+    CHECK( C[1][1] == Approx( 2.40972 ) );
+    CHECK( C[1][2] == Approx( 6.07378 ) );
+    CHECK( C[1][3] == Approx( 6.35778 ) );
+    CHECK( C[1][4] == Approx( 1.0 ) );
+
+    // Parametric coordinates outside of the knot vector and inconsistent sizes
+    CHECK_THROWS( evaluate2DCurve( { 9.5 }, x, y, knotVector ) );
+    CHECK_THROWS( evaluate2DCurve( t, x, { 0.0, 1.0 }, knotVector ) );
+}
+
+TEST_CASE("Blocked curve evaluation")
+{
+    // Sample counts that are no multiple of the block size and unordered parameter coordinates,
+    // for the kernels specialized to degrees 1 to 5 and the generic kernel and for nonuniform
+    // and uniform knot vectors
+    for( size_t p = 1; p < 8; ++p )
+    {
+        for( bool uniformKnots : { false, true } )
+        {
+            size_t n = 2 * p + 5;
+
+            std::vector<double> knotVector( p + 1, 0.0 );
+
+            for( size_t i = 1; i < n - p; ++i )
+            {
+                knotVector.push_back( uniformKnots ? 0.5 * i : i * i / 3.0 );
+            }
+
+            knotVector.resize( n + p + 1, knotVector.back( ) + ( uniformKnots ? 0.5 : 1.0 ) );
+
+            std::vector<double> x, y;
+
+            for( size_t i = 0; i < n; ++i )
+            {
+                x.push_back( 1.0 + 0.5 * i * i );
+                y.push_back( i % 3 == 0 ? -1.0 * i : 2.0 );
+            }
+
+            for( size_t numberOfSamples = 1; numberOfSamples < 20; numberOfSamples += 3 )
+            {
+                std::vector<double> t;
+
+                for( size_t i = 0; i < numberOfSamples; ++i )
+                {
+                    t.push_back( ( ( 5 * i ) % numberOfSamples ) / ( numberOfSamples - 0.5 ) * knotVector.back( ) );
+                }
+
+                std::array<std::vector<double>, 2> C1, C2;
+
+                REQUIRE_NOTHROW( C1 = evaluate2DCurve( t, x, y, knotVector ) );
+                REQUIRE_NOTHROW( C2 = evaluate2DCurveDeBoor( t, x, y, knotVector ) );
+
+                REQUIRE( C1[0].size( ) == numberOfSamples );
+                REQUIRE( C2[0].size( ) == numberOfSamples );
+
+                for( size_t i = 0; i < numberOfSamples; ++i )
+                {
+                    size_t s = findKnotSpan( t[i], n, knotVector );
+
+                    std::array<double, 2> expected = deBoorOptimized( t[i], s, p, knotVector, x, y );
+
+                    CHECK( C1[0][i] == Approx( expected[0] ).margin( 1e-12 ) );
+                    CHECK( C1[1][i] == Approx( expected[1] ).margin( 1e-12 ) );
+                    CHECK( C2[0][i] == Approx( expected[0] ).margin( 1e-12 ) );
+                    CHECK( C2[1][i] == Approx( expected[1] ).margin( 1e-12 ) );
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Curve evaluation into existing buffers")
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 1.0, 4.0, 9.0, 9.0, 9.0, 9.0 };
+    std::vector<double> x{ 0.0, 10.0, 9.0, 4.5, 1.5, 1.0 };
+    std::vector<double> y{ 0.0,  1.0, 4.0, 7.5, 6.0, 1.0 };
+    std::vector<double> t{ 0.0, 1.0, 4.0, 5.0, 9.0 };
+
+    std::array<std::vector<double>, 2> expected = evaluate2DCurve( t, x, y, knotVector );
+
+    // Write to the middle of larger buffers and check that the rest remains untouched
+    std::vector<double> curveX( t.size( ) + 2, -1.0 );
+    std::vector<double> curveY( t.size( ) + 2, -1.0 );
+
+    REQUIRE_NOTHROW( evaluate2DCurve( t.data( ), t.size( ), x, y, knotVector, &curveX[1], &curveY[1] ) );
+
+    for( size_t i = 0; i < t.size( ); ++i )
+    {
+        CHECK( curveX[i + 1] == expected[0][i] );
+        CHECK( curveY[i + 1] == expected[1][i] );
+    }
+
+    REQUIRE_NOTHROW( evaluate2DCurveDeBoor( t.data( ), t.size( ), x, y, knotVector, &curveX[1], &curveY[1] ) );
+
+    for( size_t i = 0; i < t.size( ); ++i )
+    {
+        CHECK( curveX[i + 1] == Approx( expected[0][i] ) );
+        CHECK( curveY[i + 1] == Approx( expected[1][i] ) );
+    }
+
+    CHECK( curveX.front( ) == -1.0 );
+    CHECK( curveX.back( ) == -1.0 );
+    CHECK( curveY.front( ) == -1.0 );
+    CHECK( curveY.back( ) == -1.0 );
+
+    CHECK_THROWS( evaluate2DCurve( t.data( ), t.size( ), x, { 0.0 }, knotVector, &curveX[1], &curveY[1] ) );
+}
+
+TEST_CASE("Unclamped and degree zero curves")
+{
+    std::vector<double> x{ 1.0, 2.0, 3.0, 4.0 };
+    std::vector<double> y{ 1.0, 1.0, 1.0, 1.0 };
+
+    size_t n = x.size( );
+    size_t p = 3;
+
+    // Unclamped uniform and nonuniform knot vectors, for which the curve is only defined in [t_p, t_n]
+    for( std::vector<double> knotVector : { std::vector<double>{ 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0 },
+                                            std::vector<double>{ 0.0, 1.0, 2.0, 3.0, 4.0, 6.0, 7.0, 8.0 } } )
+    {
+        std::vector<double> t{ 3.0, 3.2, 3.5, 3.9, 4.0 };
+
+        std::array<std::vector<double>, 2> C1, C2;
+
+        REQUIRE_NOTHROW( C1 = evaluate2DCurve( t, x, y, knotVector ) );
+        REQUIRE_NOTHROW( C2 = evaluate2DCurveDeBoor( t, x, y, knotVector ) );
+
+        for( size_t i = 0; i < t.size( ); ++i )
+        {
+            std::array<double, 2> expected = deBoorOptimized( t[i], findKnotSpan( t[i], n, knotVector ), p, knotVector, x, y );
+
+            CHECK( C1[0][i] == Approx( expected[0] ) );
+            CHECK( C1[1][i] == Approx( expected[1] ) );
+            CHECK( C2[0][i] == Approx( expected[0] ) );
+            CHECK( C2[1][i] == Approx( expected[1] ) );
+        }
+
+        CHECK_THROWS_AS( evaluate2DCurve( { 0.5 }, x, y, knotVector ), std::out_of_range );
+        CHECK_THROWS_AS( evaluate2DCurve( { 3.5, 2.9 }, x, y, knotVector ), std::out_of_range );
+        CHECK_THROWS_AS( evaluate2DCurveDeBoor( { 4.5 }, x, y, knotVector ), std::out_of_range );
+    }
+
+    // Degree zero, where the curve is the control point of the knot span
+    std::array<std::vector<double>, 2> C;
+
+    REQUIRE_NOTHROW( C = evaluate2DCurve( { 0.0, 0.25, 0.5, 0.75, 1.0 }, { 1.0, 2.0 }, { 3.0, 4.0 }, { 0.0, 0.5, 1.0 } ) );
+
+    CHECK( C[0] == std::vector<double>{ 1.0, 1.0, 2.0, 2.0, 2.0 } );
+    CHECK( C[1] == std::vector<double>{ 3.0, 3.0, 4.0, 4.0, 4.0 } );
+
+    REQUIRE_NOTHROW( C = evaluate2DCurveDeBoor( { 0.25, 0.75 }, { 1.0, 2.0 }, { 3.0, 4.0 }, { 0.0, 0.5, 1.0 } ) );
+
+    CHECK( C[0] == std::vector<double>{ 1.0, 2.0 } );
+    CHECK( C[1] == std::vector<double>{ 3.0, 4.0 } );
+}
+
+TEST_CASE("Streaming curve evaluation")
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 1.0, 4.0, 9.0, 9.0, 9.0, 9.0 };
+    std::vector<double> x{ 0.0, 10.0, 9.0, 4.5, 1.5, 1.0 };
+    std::vector<double> y{ 0.0,  1.0, 4.0, 7.5, 6.0, 1.0 };
+
+    size_t numberOfSamples = 1001;
+
+    std::vector<double> t( numberOfSamples );
+
+    for( size_t i = 0; i < numberOfSamples; ++i )
+    {
+        t[i] = i * 9.0 / ( numberOfSamples - 1.0 );
+    }
+
+    std::array<std::vector<double>, 2> expected = evaluate2DCurve( t, x, y, knotVector );
+
+    // Collects the streamed samples and checks that the blocks arrive in order
+    std::vector<double> streamedT, streamedX, streamedY;
+    size_t numberOfBlocks = 0;
+
+    CurveSink sink = [&]( size_t firstSample, size_t size, const double* tBlock, const double* xBlock, const double* yBlock )
+    {
+        CHECK( firstSample == streamedT.size( ) );
+        CHECK( size <= 64 );
+
+        streamedT.insert( streamedT.end( ), tBlock, tBlock + size );
+        streamedX.insert( streamedX.end( ), xBlock, xBlock + size );
+        streamedY.insert( streamedY.end( ), yBlock, yBlock + size );
+
+        numberOfBlocks++;
+    };
+
+    REQUIRE_NOTHROW( stream2DCurve( 0.0, 9.0, numberOfSamples, x, y, knotVector, sink, 64 ) );
+
+    REQUIRE( streamedT.size( ) == numberOfSamples );
+    CHECK( numberOfBlocks == 16 );
+    CHECK( streamedT.back( ) == 9.0 );
+
+    for( size_t i = 0; i < numberOfSamples; ++i )
+    {
+        CHECK( streamedT[i] == Approx( t[i] ) );
+        CHECK( streamedX[i] == Approx( expected[0][i] ) );
+        CHECK( streamedY[i] == Approx( expected[1][i] ) );
+    }
+
+    // Parameter coordinates read from a source in chunks that are smaller than the blocks
+    size_t next = 0;
+
+    ParameterSource source = [&]( double* tBlock, size_t capacity )
+    {
+        size_t size = std::min( std::min( capacity, size_t { 10 } ), t.size( ) - next );
+
+        std::copy( t.begin( ) + next, t.begin( ) + next + size, tBlock );
+
+        next += size;
+
+        return size;
+    };
+
+    streamedT.clear( );
+    streamedX.clear( );
+    streamedY.clear( );
+
+    REQUIRE_NOTHROW( stream2DCurve( source, x, y, knotVector, sink, 64 ) );
+
+    REQUIRE( streamedX.size( ) == numberOfSamples );
+
+    for( size_t i = 0; i < numberOfSamples; ++i )
+    {
+        CHECK( streamedX[i] == expected[0][i] );
+        CHECK( streamedY[i] == expected[1][i] );
+    }
+
+    // No samples, a single sample and invalid arguments
+    numberOfBlocks = 0;
+
+    REQUIRE_NOTHROW( stream2DCurve( 0.0, 9.0, 0, x, y, knotVector, sink ) );
+
+    CHECK( numberOfBlocks == 0 );
+
+    streamedT.clear( );
+    streamedX.clear( );
+    streamedY.clear( );
+
+    REQUIRE_NOTHROW( stream2DCurve( 4.0, 9.0, 1, x, y, knotVector, sink ) );
+
+    REQUIRE( streamedT.size( ) == 1 );
+    CHECK( streamedT[0] == 4.0 );
+
+    CHECK_THROWS( stream2DCurve( 0.0, 9.0, 10, x, y, knotVector, sink, 0 ) );
+    CHECK_THROWS( stream2DCurve( 0.0, 9.0, 10, x, { 0.0 }, knotVector, sink ) );
+    CHECK_THROWS( stream2DCurve( 0.0, 9.5, 10, x, y, knotVector, sink ) );
+}
+
 } // namespace splinekernel
 } // namespace cie
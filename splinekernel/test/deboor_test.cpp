@@ -2,6 +2,7 @@
 #include "curve.hpp"
 
 #include <array>
+#include <limits>
 #include <vector>
 
 namespace cie
@@ -25,6 +26,32 @@ TEST_CASE("FindKnotSpan_test")
     CHECK( findKnotSpan( 9.0, n, knotVector ) == 5 );
 
     CHECK_THROWS(findKnotSpan(9.1, n, knotVector));
+    CHECK_THROWS( findKnotSpan( std::numeric_limits<double>::quiet_NaN( ), n, knotVector ) );
+}
+
+TEST_CASE("KnotSpanCursor_test")
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 1.0, 2.0, 2.0, 3.0, 5.0, 6.0, 7.0, 8.0, 9.0, 9.0, 9.0, 9.0 };
+
+    size_t n = knotVector.size( ) - 3 - 1;
+
+    // Sorted, unsorted and repeated coordinates, jumps over many spans and back again
+    std::vector<double> t{ 0.0, 0.0, 0.5, 1.0, 1.5, 2.0, 2.0, 4.0, 8.5, 9.0,
+                           0.2, 6.0, 5.99, 2.0, 1.99, 9.0, 9.0, 3.0, 7.0, 7.5 };
+
+    KnotSpanCursor cursor( n, knotVector );
+
+    for( size_t i = 0; i < t.size( ); ++i )
+    {
+        CHECK( cursor.find( t[i] ) == findKnotSpan( t[i], n, knotVector ) );
+    }
+
+    CHECK_THROWS( cursor.find( -0.1 ) );
+    CHECK_THROWS( cursor.find( 9.1 ) );
+    CHECK_THROWS( cursor.find( std::numeric_limits<double>::quiet_NaN( ) ) );
+
+    // Cursor is still usable after an exception
+    CHECK( cursor.find( 4.5 ) == 7 );
 }
 
 TEST_CASE("DeBoor_test")
@@ -66,6 +93,33 @@ TEST_CASE("DeBoor_test")
     CHECK( P[1] == Approx( y.back( ) ) );
 }
 
+TEST_CASE( "DeBoorOptimized_test" )
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 1.0, 4.0, 9.0, 9.0, 9.0, 9.0 };
+
+    std::vector<double> x{ 0.5, 10.0, 9.0, 4.5, 1.5, 1.0 };
+    std::vector<double> y{ 0.5,  1.0, 4.0, 7.5, 6.0, 1.0 };
+
+    size_t n = x.size( );
+    size_t p = knotVector.size( ) - n - 1;
+
+    std::vector<double> workspace( 2 * ( p + 1 ) );
+
+    for( double t : { 0.0, 0.7, 1.1, 3.9, 4.0, 8.2, 9.0 } )
+    {
+        size_t s = findKnotSpan( t, n, knotVector );
+
+        std::array<double, 2> expected = deBoor( t, s, p, knotVector, x, y );
+        std::array<double, 2> P1 = deBoorOptimized( t, s, p, knotVector, x, y );
+        std::array<double, 2> P2 = deBoorOptimized( t, s, p, knotVector, x, y, workspace.data( ) );
+
+        CHECK( P1[0] == Approx( expected[0] ) );
+        CHECK( P1[1] == Approx( expected[1] ) );
+        CHECK( P2[0] == Approx( expected[0] ) );
+        CHECK( P2[1] == Approx( expected[1] ) );
+    }
+}
+
 TEST_CASE( "DeBoorCurve_test" )
 {
     // This is the same test as in the curve test because given the same setup,
@@ -0,0 +1,156 @@
+#include "catch.hpp"
+#include "evaluationplan.hpp"
+#include "basisfunctions.hpp"
+#include "curve.hpp"
+#include "surface.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+TEST_CASE( "EvaluationPlan_curve_test" )
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 1.0, 4.0, 9.0, 9.0, 9.0, 9.0 };
+    std::vector<double> t{ 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0 };
+
+    std::vector<double> x{ 0.0, 10.0, 9.0, 4.5, 1.5, 1.0 };
+    std::vector<double> y{ 0.0,  1.0, 4.0, 7.5, 6.0, 1.0 };
+
+    EvaluationPlan plan( t, x.size( ), knotVector );
+
+    REQUIRE( plan.numberOfSamples( ) == t.size( ) );
+    REQUIRE( plan.numberOfControlPoints( ) == x.size( ) );
+    REQUIRE( plan.polynomialDegree( ) == 3 );
+
+    CHECK( plan.firstControlPoint( 0 ) == 0 );
+    CHECK( plan.firstControlPoint( 9 ) == 2 );
+
+    std::array<std::vector<double>, 2> C;
+
+    // Evaluate twice with different control points using the same plan
+    for( size_t iEvaluation = 0; iEvaluation < 2; ++iEvaluation )
+    {
+        REQUIRE_NOTHROW( C = plan.evaluate( x, y ) );
+
+        std::array<std::vector<double>, 2> expected = evaluate2DCurve( t, x, y, knotVector );
+
+        REQUIRE( C[0].size( ) == t.size( ) );
+        REQUIRE( C[1].size( ) == t.size( ) );
+
+        for( size_t i = 0; i < t.size( ); ++i )
+        {
+            CHECK( C[0][i] == Approx( expected[0][i] ) );
+            CHECK( C[1][i] == Approx( expected[1][i] ) );
+        }
+
+        x[2] = -3.0;
+        y[3] = 12.0;
+    }
+
+    CHECK_THROWS( plan.evaluate( { 1.0, 2.0 } ) );
+    CHECK_THROWS( EvaluationPlan( { 9.5 }, x.size( ), knotVector ) );
+
+    // Unclamped knot vectors, where only [t_p, t_n] has p + 1 nonzero basis functions
+    std::vector<double> unclamped{ 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7 };
+    std::vector<double> unclampedNonuniform{ 0.0, 0.1, 0.2, 0.3, 0.4, 0.55, 0.6, 0.7 };
+
+    for( const auto& kv : { unclamped, unclampedNonuniform } )
+    {
+        REQUIRE_NOTHROW( EvaluationPlan( { 0.3, 0.35, 0.4 }, 4, kv ) );
+
+        CHECK( EvaluationPlan( { 0.3, 0.35, 0.4 }, 4, kv ).firstControlPoint( 2 ) == 0 );
+
+        CHECK_THROWS_AS( EvaluationPlan( { 0.05 }, 4, kv ), std::out_of_range );
+        CHECK_THROWS_AS( EvaluationPlan( { 0.3, 0.5 }, 4, kv ), std::out_of_range );
+        CHECK_THROWS_AS( EvaluationPlan( { 0.05 }, 4, kv, 1 ), std::out_of_range );
+    }
+
+    linalg::Matrix controlPoints( 4, 4, 1.0 );
+
+    CHECK_THROWS_AS( evaluateSurface( { unclamped, unclamped }, { controlPoints }, { 5, 5 } ), std::out_of_range );
+}
+
+TEST_CASE( "EvaluationPlan_surface_test" )
+{
+    std::vector<double> knotVectorR{ 0.0, 0.0, 0.0, 0.5, 1.0, 1.0, 1.0 };
+    std::vector<double> knotVectorS{ 0.0, 0.0, 0.5, 1.0, 1.0 };
+
+    std::vector<double> r{ 0.0, 0.2, 0.5, 0.9, 1.0 };
+    std::vector<double> s{ 0.0, 0.25, 0.5, 0.75, 1.0 };
+
+    linalg::Matrix zGrid( { 1.0, 2.0, 0.5,
+                            3.0, 1.0, 1.0,
+                            0.0, 2.0, 4.0,
+                            1.0, 1.0, 2.0 }, 4 );
+
+    std::array<EvaluationPlan, 2> plans{ EvaluationPlan( r, 4, knotVectorR ), EvaluationPlan( s, 3, knotVectorS ) };
+
+    VectorOfMatrices C;
+
+    REQUIRE_NOTHROW( C = evaluateSurface( plans, { zGrid } ) );
+
+    REQUIRE( C.size( ) == 1 );
+    REQUIRE( C[0].size1( ) == r.size( ) );
+    REQUIRE( C[0].size2( ) == s.size( ) );
+
+    // Compare with a curve in r-direction through the interpolated control points in s-direction
+    for( size_t iS = 0; iS < s.size( ); ++iS )
+    {
+        std::vector<double> column( 4 );
+
+        for( size_t iCP = 0; iCP < 4; ++iCP )
+        {
+            std::vector<double> row{ zGrid( iCP, 0 ), zGrid( iCP, 1 ), zGrid( iCP, 2 ) };
+
+            column[iCP] = plans[1].evaluate( row )[iS];
+        }
+
+        std::vector<double> expected = plans[0].evaluate( column );
+
+        for( size_t iR = 0; iR < r.size( ); ++iR )
+        {
+            CHECK( C[0]( iR, iS ) == Approx( expected[iR] ) );
+        }
+    }
+
+    // Grid of control points does not match the plans
+    CHECK_THROWS( evaluateSurface( { plans[1], plans[0] }, { zGrid } ) );
+}
+
+TEST_CASE( "EvaluationPlan_derivatives_test" )
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 1.0, 4.0, 4.0, 9.0, 9.0, 9.0, 9.0 };
+    std::vector<double> t{ 0.0, 0.5, 1.0, 2.5, 4.0, 6.0, 9.0 };
+
+    EvaluationPlan plan( t, 7, knotVector, 2 );
+    EvaluationPlan valuesOnly( t, 7, knotVector );
+
+    REQUIRE( plan.numberOfDerivatives( ) == 2 );
+    REQUIRE( valuesOnly.numberOfDerivatives( ) == 0 );
+
+    BasisFunctionDerivatives expected = evaluateBSplineBasisDerivatives( t, 3, 2, knotVector );
+
+    for( size_t iT = 0; iT < t.size( ); ++iT )
+    {
+        REQUIRE( plan.firstControlPoint( iT ) == valuesOnly.firstControlPoint( iT ) );
+        REQUIRE( plan.basisDerivatives( iT, 0 ) == plan.basisValues( iT ) );
+
+        for( size_t i = 0; i < 4; ++i )
+        {
+            CHECK( plan.basisValues( iT )[i] == Approx( valuesOnly.basisValues( iT )[i] ).margin( 1e-12 ) );
+
+            for( size_t k = 0; k <= 2; ++k )
+            {
+                CHECK( plan.basisDerivatives( iT, k )[i] == Approx( expected( iT, k, i ) ).margin( 1e-12 ) );
+            }
+        }
+    }
+}
+
+} // namespace splinekernel
+} // namespace cie
@@ -0,0 +1,389 @@
+#include "catch.hpp"
+#include "fitting.hpp"
+#include "interpolation.hpp"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+TEST_CASE( "knotVectorForFitting_test" )
+{
+    std::vector<double> parameterPositions{ 0.0, 0.1, 0.25, 0.3, 0.5, 0.6, 0.8, 0.9, 1.0 };
+
+    // Interpolation is the same as averaging
+    CHECK( knotVectorForFitting( parameterPositions, 3, 9 ) == knotVectorUsingAveraging( parameterPositions, 3 ) );
+
+    // 9 points and 5 control points: d = 4.5, such that the only inner knot is at 0.5 * ( 0.3 + 0.5 )
+    std::vector<double> knotVector = knotVectorForFitting( parameterPositions, 3, 5 );
+
+    REQUIRE( knotVector.size( ) == 9 );
+
+    CHECK( knotVector[3] == Approx( 0.0 ) );
+    CHECK( knotVector[4] == Approx( 0.4 ) );
+    CHECK( knotVector[5] == Approx( 1.0 ) );
+
+    CHECK_THROWS( knotVectorForFitting( parameterPositions, 3, 10 ) );
+    CHECK_THROWS( knotVectorForFitting( parameterPositions, 3, 3 ) );
+    CHECK_THROWS( knotVectorForFitting( parameterPositions, 0, 5 ) );
+}
+
+TEST_CASE( "BSplineFit_test" )
+{
+    // Interpolation gives the same control points as interpolateWithBSplineCurveND
+    ControlPointsND points{ { 0.0, 15.0, 171.0, 307.0, 907.0, 1000.0, 1300.0 },
+                            { 0.0, 20.0, 85.0, 340.0, 515.0, 300.0, 320.0 } };
+
+    ControlPointsNDAndKnotVector expected = interpolateWithBSplineCurveND( points, 3 );
+
+    std::vector<double> parameterPositions = centripetalParameterPositionsND( points );
+
+    BSplineFit interpolation( parameterPositions, KnotVector( 7, expected.second ) );
+
+    REQUIRE( interpolation.interpolates( ) );
+
+    for( size_t iComponent = 0; iComponent < 2; ++iComponent )
+    {
+        std::vector<double> controlPoints = interpolation.fit( points[iComponent] );
+
+        REQUIRE( controlPoints.size( ) == 7 );
+
+        for( size_t i = 0; i < 7; ++i )
+        {
+            CHECK( controlPoints[i] == Approx( expected.first[iComponent][i] ) );
+        }
+    }
+
+    // Least squares fit of values sampled from a spline of the same space recovers its control points
+    std::vector<double> t( 50 );
+
+    for( size_t i = 0; i < t.size( ); ++i )
+    {
+        t[i] = std::pow( i / 49.0, 1.5 );
+    }
+
+    std::vector<double> knots = knotVectorForFitting( t, 3, 8 );
+    std::vector<double> controlPoints{ 1.0, -2.0, 0.5, 3.0, 4.0, -1.0, 0.0, 2.0 };
+
+    std::vector<double> values = EvaluationPlan( t, 8, knots ).evaluate( controlPoints );
+
+    BSplineFit approximation( t, KnotVector( 8, knots ) );
+
+    REQUIRE( approximation.numberOfPoints( ) == 50 );
+    REQUIRE( approximation.numberOfControlPoints( ) == 8 );
+    REQUIRE( !approximation.interpolates( ) );
+
+    std::vector<double> computed = approximation.fit( values );
+
+    for( size_t i = 0; i < controlPoints.size( ); ++i )
+    {
+        CHECK( computed[i] == Approx( controlPoints[i] ).margin( 1e-10 ) );
+    }
+
+    // The residual of the least squares solution is orthogonal to perturbations of the control points
+    std::vector<double> noisy = values;
+
+    for( size_t i = 0; i < noisy.size( ); ++i )
+    {
+        noisy[i] += 0.1 * std::sin( 7.0 * i );
+    }
+
+    computed = approximation.fit( noisy );
+
+    std::vector<double> residual = EvaluationPlan( t, 8, knots ).evaluate( computed );
+
+    for( size_t iCP = 0; iCP < 8; ++iCP )
+    {
+        std::vector<double> unit( 8, 0.0 );
+
+        unit[iCP] = 1.0;
+
+        std::vector<double> basis = EvaluationPlan( t, 8, knots ).evaluate( unit );
+
+        double dot = 0.0;
+
+        for( size_t i = 0; i < t.size( ); ++i )
+        {
+            dot += basis[i] * ( noisy[i] - residual[i] );
+        }
+
+        CHECK( dot == Approx( 0.0 ).margin( 1e-10 ) );
+    }
+
+    CHECK_THROWS( approximation.fit( std::vector<double>( 49, 0.0 ) ) );
+
+    // A corrupted value with zero weight does not influence the weighted fit
+    std::vector<double> weights( t.size( ), 2.0 );
+    std::vector<double> corrupted = values;
+
+    weights[17] = 0.0;
+    corrupted[17] += 100.0;
+
+    computed = BSplineFit( t, KnotVector( 8, knots ), weights ).fit( corrupted );
+
+    for( size_t i = 0; i < controlPoints.size( ); ++i )
+    {
+        CHECK( computed[i] == Approx( controlPoints[i] ).margin( 1e-10 ) );
+    }
+
+    CHECK_THROWS( BSplineFit( t, KnotVector( 8, knots ), std::vector<double>( 49, 1.0 ) ) );
+    CHECK_THROWS( BSplineFit( t, KnotVector( 8, knots ), std::vector<double>( 50, -1.0 ) ) );
+
+    // Scaling all weights does not change the fit, even if the normal equations get tiny pivots
+    std::vector<double> unscaledWeights( t.size( ) ), scaledWeights( t.size( ) );
+
+    for( size_t i = 0; i < t.size( ); ++i )
+    {
+        unscaledWeights[i] = 1.0 + i % 3;
+        scaledWeights[i] = 1e-14 * unscaledWeights[i];
+    }
+
+    std::vector<double> unscaled = BSplineFit( t, KnotVector( 8, knots ), unscaledWeights ).fit( noisy );
+    std::vector<double> scaled;
+
+    REQUIRE_NOTHROW( scaled = BSplineFit( t, KnotVector( 8, knots ), scaledWeights ).fit( noisy ) );
+
+    for( size_t i = 0; i < controlPoints.size( ); ++i )
+    {
+        CHECK( scaled[i] == Approx( unscaled[i] ).epsilon( 1e-10 ) );
+    }
+
+    // Fewer points than control points, unsorted points and points outside of the knot vector bounds
+    CHECK_THROWS( BSplineFit( { 0.0, 0.5, 1.0 }, KnotVector( 8, knots ) ) );
+    CHECK_THROWS( BSplineFit( { 0.0, 0.2, 0.1, 0.3, 0.4, 0.5, 0.6, 1.0 }, KnotVector( 8, knots ) ) );
+    CHECK_THROWS( BSplineFit( { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 1.1 }, KnotVector( 8, knots ) ) );
+
+    // Singular system with coinciding parameter positions
+    CHECK_THROWS( BSplineFit( { 0.0, 0.1, 0.1, 0.3, 0.4, 0.5, 0.6, 1.0 }, KnotVector( 8, knotVectorForFitting( { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 1.0 }, 3, 8 ) ) ) );
+}
+
+TEST_CASE( "approximateWithBSplineCurve_test" )
+{
+    // Noisy samples of a circle with three components, of which the last is not geometric
+    size_t numberOfPoints = 2000;
+
+    ControlPointsND points( 3, std::vector<double>( numberOfPoints ) );
+
+    for( size_t i = 0; i < numberOfPoints; ++i )
+    {
+        double phi = 6.0 * i / ( numberOfPoints - 1.0 );
+
+        points[0][i] = std::cos( phi ) + 1e-3 * std::sin( 91.0 * i );
+        points[1][i] = std::sin( phi ) + 1e-3 * std::cos( 37.0 * i );
+        points[2][i] = phi;
+    }
+
+    ControlPointsNDAndKnotVector result;
+
+    REQUIRE_NOTHROW( result = approximateWithBSplineCurveND( points, 3, 20, { }, 2 ) );
+
+    REQUIRE( result.first.size( ) == 3 );
+    REQUIRE( result.first[0].size( ) == 20 );
+    REQUIRE( result.second.size( ) == 24 );
+
+    // The approximation is close to the points at their parameter positions
+    std::vector<double> t = centripetalParameterPositionsND( points, 2 );
+
+    EvaluationPlan plan( t, 20, result.second );
+
+    for( size_t iComponent = 0; iComponent < 3; ++iComponent )
+    {
+        std::vector<double> values = plan.evaluate( result.first[iComponent] );
+
+        for( size_t i = 0; i < numberOfPoints; ++i )
+        {
+            CHECK( values[i] == Approx( points[iComponent][i] ).margin( 1e-2 ) );
+        }
+    }
+
+    // Large weights pin the end points
+    std::vector<double> weights( numberOfPoints, 1.0 );
+
+    weights.front( ) = 1e8;
+    weights.back( ) = 1e8;
+
+    REQUIRE_NOTHROW( result = approximateWithBSplineCurveND( points, 3, 20, weights, 2 ) );
+
+    for( size_t iComponent = 0; iComponent < 3; ++iComponent )
+    {
+        CHECK( result.first[iComponent].front( ) == Approx( points[iComponent].front( ) ).margin( 1e-6 ) );
+        CHECK( result.first[iComponent].back( ) == Approx( points[iComponent].back( ) ).margin( 1e-6 ) );
+    }
+
+    // With one control point per point, approximation is interpolation
+    ControlPoints2D points2D{ { { 0.0, 15.0, 171.0, 307.0, 907.0 }, { 0.0, 20.0, 85.0, 340.0, 515.0 } } };
+
+    ControlPointsAndKnotVector interpolation = interpolateWithBSplineCurve( points2D, 2 );
+    ControlPointsAndKnotVector approximation = approximateWithBSplineCurve( points2D, 2, 5 );
+
+    CHECK( approximation.second == interpolation.second );
+
+    for( size_t i = 0; i < 5; ++i )
+    {
+        CHECK( approximation.first[0][i] == Approx( interpolation.first[0][i] ) );
+        CHECK( approximation.first[1][i] == Approx( interpolation.first[1][i] ) );
+    }
+
+    CHECK_THROWS( approximateWithBSplineCurve( points2D, 2, 6 ) );
+    CHECK_THROWS( approximateWithBSplineCurve( points2D, 2, 4, { 1.0, 1.0 } ) );
+    CHECK_THROWS( approximateWithBSplineCurveND( { points[0], { 1.0, 2.0 } }, 2, 4 ) );
+    CHECK_THROWS( approximateWithBSplineCurveND( { }, 2, 4 ) );
+}
+
+TEST_CASE( "interpolateWithBSplineSurface_test" )
+{
+    // Larger than the blocks of grid lines solved together
+    size_t numberOfPointsR = 70;
+    size_t numberOfPointsS = 131;
+
+    VectorOfMatrices gridPoints( 2, linalg::Matrix( numberOfPointsR, numberOfPointsS, 0.0 ) );
+
+    for( size_t i = 0; i < numberOfPointsR; ++i )
+    {
+        for( size_t j = 0; j < numberOfPointsS; ++j )
+        {
+            gridPoints[0]( i, j ) = std::sin( 0.1 * i ) * std::cos( 0.05 * j );
+            gridPoints[1]( i, j ) = std::cos( 0.3 * i + 0.02 * j * j );
+        }
+    }
+
+    SurfaceControlPointsAndKnotVectors result;
+
+    REQUIRE_NOTHROW( result = interpolateWithBSplineSurface( gridPoints, { 3, 2 } ) );
+
+    const VectorOfMatrices& controlPoints = result.first;
+    const std::array<std::vector<double>, 2>& knotVectors = result.second;
+
+    REQUIRE( controlPoints.size( ) == 2 );
+    REQUIRE( controlPoints[0].size1( ) == numberOfPointsR );
+    REQUIRE( controlPoints[0].size2( ) == numberOfPointsS );
+    REQUIRE( knotVectors[0].size( ) == numberOfPointsR + 4 );
+    REQUIRE( knotVectors[1].size( ) == numberOfPointsS + 3 );
+
+    // Evaluating at the equidistant parameter positions reproduces the grid
+    VectorOfMatrices surface = evaluateSurface( knotVectors, controlPoints, { numberOfPointsR, numberOfPointsS } );
+
+    for( size_t iComponent = 0; iComponent < 2; ++iComponent )
+    {
+        for( size_t i = 0; i < numberOfPointsR; ++i )
+        {
+            for( size_t j = 0; j < numberOfPointsS; ++j )
+            {
+                CHECK( surface[iComponent]( i, j ) == Approx( gridPoints[iComponent]( i, j ) ).margin( 1e-10 ) );
+            }
+        }
+    }
+
+    // Given parameter positions
+    std::vector<double> r{ 0.0, 0.5, 1.5, 2.0, 3.5, 4.0 };
+    std::vector<double> s{ -1.0, 0.0, 0.2, 0.7, 1.0 };
+
+    linalg::Matrix zGrid( r.size( ), s.size( ), 0.0 );
+
+    for( size_t i = 0; i < r.size( ); ++i )
+    {
+        for( size_t j = 0; j < s.size( ); ++j )
+        {
+            zGrid( i, j ) = r[i] * r[i] - 2.0 * s[j] + std::sin( r[i] * s[j] );
+        }
+    }
+
+    REQUIRE_NOTHROW( result = interpolateWithBSplineSurface( { r, s }, { zGrid }, { 2, 3 } ) );
+
+    CHECK( result.second[0].front( ) == 0.0 );
+    CHECK( result.second[0].back( ) == 4.0 );
+    CHECK( result.second[1].front( ) == -1.0 );
+    CHECK( result.second[1].back( ) == 1.0 );
+
+    std::array<EvaluationPlan, 2> plans{ EvaluationPlan( r, r.size( ), result.second[0] ),
+                                         EvaluationPlan( s, s.size( ), result.second[1] ) };
+
+    surface = evaluateSurface( plans, result.first );
+
+    for( size_t i = 0; i < r.size( ); ++i )
+    {
+        for( size_t j = 0; j < s.size( ); ++j )
+        {
+            CHECK( surface[0]( i, j ) == Approx( zGrid( i, j ) ).margin( 1e-10 ) );
+        }
+    }
+
+    CHECK_THROWS( interpolateWithBSplineSurface( { s, r }, { zGrid }, { 2, 3 } ) );
+    CHECK_THROWS( interpolateWithBSplineSurface( { r, s }, { }, { 2, 3 } ) );
+    CHECK_THROWS( interpolateWithBSplineSurface( { r, s }, { zGrid }, { 2, 5 } ) );
+}
+
+TEST_CASE( "approximateWithBSplineSurface_test" )
+{
+    size_t numberOfPointsR = 90;
+    size_t numberOfPointsS = 40;
+
+    // Sample a surface from the approximation space, which the least squares fit must reproduce
+    std::vector<double> r( numberOfPointsR ), s( numberOfPointsS );
+
+    for( size_t i = 0; i < numberOfPointsR; ++i )
+    {
+        r[i] = i / ( numberOfPointsR - 1.0 );
+    }
+
+    for( size_t j = 0; j < numberOfPointsS; ++j )
+    {
+        s[j] = j / ( numberOfPointsS - 1.0 );
+    }
+
+    std::array<std::vector<double>, 2> knotVectors{ knotVectorForFitting( r, 3, 12 ), knotVectorForFitting( s, 2, 6 ) };
+
+    linalg::Matrix controlPoints( 12, 6, 0.0 );
+
+    for( size_t i = 0; i < 12; ++i )
+    {
+        for( size_t j = 0; j < 6; ++j )
+        {
+            controlPoints( i, j ) = std::sin( 1.0 + i + 3.0 * j );
+        }
+    }
+
+    VectorOfMatrices gridPoints = evaluateSurface( knotVectors, { controlPoints }, { numberOfPointsR, numberOfPointsS } );
+
+    SurfaceControlPointsAndKnotVectors result;
+
+    REQUIRE_NOTHROW( result = approximateWithBSplineSurface( gridPoints, { 3, 2 }, { 12, 6 } ) );
+
+    REQUIRE( result.first.size( ) == 1 );
+    REQUIRE( result.first[0].size1( ) == 12 );
+    REQUIRE( result.first[0].size2( ) == 6 );
+
+    CHECK( result.second == knotVectors );
+
+    for( size_t i = 0; i < 12; ++i )
+    {
+        for( size_t j = 0; j < 6; ++j )
+        {
+            CHECK( result.first[0]( i, j ) == Approx( controlPoints( i, j ) ).margin( 1e-10 ) );
+        }
+    }
+
+    // Reusing the factorized fits for another set of values
+    std::array<BSplineFit, 2> fits{ BSplineFit( r, KnotVector( 12, knotVectors[0] ) ),
+                                    BSplineFit( s, KnotVector( 6, knotVectors[1] ) ) };
+
+    VectorOfMatrices scaled = fitBSplineSurface( fits, { linalg::Matrix( numberOfPointsR, numberOfPointsS, 2.0 ) } );
+
+    for( size_t i = 0; i < 12; ++i )
+    {
+        for( size_t j = 0; j < 6; ++j )
+        {
+            CHECK( scaled[0]( i, j ) == Approx( 2.0 ) );
+        }
+    }
+
+    CHECK_THROWS( fitBSplineSurface( fits, { linalg::Matrix( numberOfPointsS, numberOfPointsR, 2.0 ) } ) );
+    CHECK_THROWS( approximateWithBSplineSurface( gridPoints, { 3, 2 }, { 91, 6 } ) );
+}
+
+} // namespace splinekernel
+} // namespace cie
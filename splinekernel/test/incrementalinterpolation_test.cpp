@@ -0,0 +1,158 @@
+#include "catch.hpp"
+#include "incrementalinterpolation.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+namespace
+{
+
+void checkEqual( const ControlPointsNDAndKnotVector& result,
+                 const ControlPointsNDAndKnotVector& expected )
+{
+    REQUIRE( result.first.size( ) == expected.first.size( ) );
+    REQUIRE( result.second.size( ) == expected.second.size( ) );
+
+    for( size_t iComponent = 0; iComponent < result.first.size( ); ++iComponent )
+    {
+        REQUIRE( result.first[iComponent].size( ) == expected.first[iComponent].size( ) );
+
+        for( size_t i = 0; i < result.first[iComponent].size( ); ++i )
+        {
+            CHECK( result.first[iComponent][i] == Approx( expected.first[iComponent][i] ).margin( 1e-9 ) );
+        }
+    }
+
+    for( size_t i = 0; i < result.second.size( ); ++i )
+    {
+        CHECK( result.second[i] == Approx( expected.second[i] ).margin( 1e-12 ) );
+    }
+}
+
+} // namespace
+
+TEST_CASE( "IncrementalInterpolator_test" )
+{
+    for( size_t p = 1; p < 5; ++p )
+    {
+        IncrementalInterpolator interpolator( p, 2 );
+
+        REQUIRE( interpolator.polynomialDegree( ) == p );
+        REQUIRE( interpolator.numberOfComponents( ) == 2 );
+
+        ControlPointsND points( 2 );
+
+        for( size_t i = 0; i < 40; ++i )
+        {
+            double phi = 0.3 * i;
+
+            std::vector<double> point{ phi * std::cos( phi ), ( 1.0 + 0.1 * i ) * std::sin( phi ) };
+            std::vector<double> tentative{ point[0] + 0.5, point[1] - 0.25 };
+
+            // Not enough points yet for the polynomial degree
+            if( i < p )
+            {
+                CHECK_THROWS( interpolator.interpolate( ) );
+            }
+
+            // Preview a tentative point, as when moving the mouse
+            if( i >= p )
+            {
+                ControlPointsND previewPoints = points;
+
+                previewPoints[0].push_back( tentative[0] );
+                previewPoints[1].push_back( tentative[1] );
+
+                checkEqual( interpolator.preview( tentative ), interpolateWithBSplineCurveND( previewPoints, p ) );
+            }
+
+            // Interpolating right after a preview does not include the tentative point
+            if( i > p )
+            {
+                checkEqual( interpolator.interpolate( ), interpolateWithBSplineCurveND( points, p ) );
+            }
+
+            REQUIRE_NOTHROW( interpolator.append( point ) );
+
+            points[0].push_back( point[0] );
+            points[1].push_back( point[1] );
+
+            REQUIRE( interpolator.numberOfPoints( ) == i + 1 );
+
+            if( i >= p )
+            {
+                checkEqual( interpolator.interpolate( ), interpolateWithBSplineCurveND( points, p ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "IncrementalInterpolatorFailingAppend_test" )
+{
+    size_t p = 3;
+
+    IncrementalInterpolator interpolator( p, 2 );
+
+    ControlPointsND points( 2 );
+
+    for( size_t i = 0; i < 12; ++i )
+    {
+        std::vector<double> point{ std::cos( 0.5 * i ), 0.2 * i + std::sin( 0.5 * i ) };
+
+        // Repeating the last point gives a singular system
+        if( i > p )
+        {
+            CHECK_THROWS( interpolator.append( { points[0].back( ), points[1].back( ) } ) );
+
+            REQUIRE( interpolator.numberOfPoints( ) == i );
+
+            checkEqual( interpolator.interpolate( ), interpolateWithBSplineCurveND( points, p ) );
+        }
+
+        REQUIRE_NOTHROW( interpolator.append( point ) );
+
+        points[0].push_back( point[0] );
+        points[1].push_back( point[1] );
+
+        if( i >= p )
+        {
+            checkEqual( interpolator.interpolate( ), interpolateWithBSplineCurveND( points, p ) );
+        }
+    }
+}
+
+TEST_CASE( "IncrementalInterpolatorND_test" )
+{
+    size_t p = 3;
+
+    // x, y, z and one scalar channel which must not affect the parameterization
+    IncrementalInterpolator interpolator( p, 4, 3 );
+
+    ControlPointsND points( 4 );
+
+    for( size_t i = 0; i < 20; ++i )
+    {
+        std::vector<double> point{ std::cos( 0.4 * i ), std::sin( 0.4 * i ), 0.1 * i * i, 100.0 * i };
+
+        interpolator.append( point );
+
+        for( size_t iComponent = 0; iComponent < 4; ++iComponent )
+        {
+            points[iComponent].push_back( point[iComponent] );
+        }
+    }
+
+    checkEqual( interpolator.interpolate( ), interpolateWithBSplineCurveND( points, p, 3 ) );
+
+    CHECK_THROWS( interpolator.append( { 1.0, 2.0 } ) );
+    CHECK_THROWS( IncrementalInterpolator( 0, 2 ) );
+    CHECK_THROWS( IncrementalInterpolator( 2, 2, 3 ) );
+}
+
+} // namespace splinekernel
+} // namespace cie
@@ -0,0 +1,111 @@
+#include "catch.hpp"
+#include "instrumentation.hpp"
+#include "curve.hpp"
+
+#include <string>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+namespace
+{
+
+const InstrumentationRecord* findRecord( const std::vector<InstrumentationRecord>& report,
+                                         const std::string& name )
+{
+    for( const auto& record : report )
+    {
+        if( record.name == name )
+        {
+            return &record;
+        }
+    }
+
+    return nullptr;
+}
+
+void timedFunction( size_t numberOfSamples )
+{
+    // Unused if instrumentation is disabled
+    (void)numberOfSamples;
+
+    SPLINEKERNEL_TIME_SCOPE( "instrumentation test", numberOfSamples );
+}
+
+} // namespace
+
+TEST_CASE( "Instrumentation_test" )
+{
+    std::vector<double> knotVector { 0.0, 0.0, 0.0, 0.5, 1.0, 1.0, 1.0 };
+    std::vector<double> x { 0.0, 1.0, 2.0, 3.0 };
+    std::vector<double> y { 1.0, 0.0, 1.0, 0.0 };
+    std::vector<double> t { 0.0, 0.1, 0.4, 0.6, 0.9 };
+
+    resetInstrumentation( );
+
+    timedFunction( 3 );
+    timedFunction( 4 );
+
+    evaluate2DCurve( t, x, y, knotVector );
+    evaluate2DCurve( t, x, y, knotVector );
+
+    REQUIRE_NOTHROW( findKnotSpan( 0.7, 4, knotVector ) );
+
+    std::vector<InstrumentationRecord> report = instrumentationReport( );
+
+    if( !instrumentationEnabled( ) )
+    {
+        CHECK( report.empty( ) );
+
+        return;
+    }
+
+    const InstrumentationRecord* record = findRecord( report, "instrumentation test" );
+
+    REQUIRE( record != nullptr );
+    CHECK( record->numberOfCalls == 2 );
+    CHECK( record->numberOfSamples == 7 );
+    CHECK( record->seconds >= 0.0 );
+
+    record = findRecord( report, "evaluate2DCurve" );
+
+    REQUIRE( record != nullptr );
+    CHECK( record->numberOfCalls == 2 );
+    CHECK( record->numberOfSamples == 10 );
+
+    record = findRecord( report, "curve/knot span search" );
+
+    REQUIRE( record != nullptr );
+    CHECK( record->numberOfSamples == 10 );
+
+    record = findRecord( report, "curve/evaluation" );
+
+    REQUIRE( record != nullptr );
+    CHECK( record->numberOfSamples == 10 );
+
+    // Only the direct call is counted, the curve evaluation searches knot spans without timing each
+    record = findRecord( report, "findKnotSpan" );
+
+    REQUIRE( record != nullptr );
+    CHECK( record->numberOfCalls == 1 );
+
+    // Sorted by name
+    for( size_t i = 1; i < report.size( ); ++i )
+    {
+        CHECK( report[i - 1].name < report[i].name );
+    }
+
+    resetInstrumentation( );
+
+    for( const auto& entry : instrumentationReport( ) )
+    {
+        CHECK( entry.numberOfCalls == 0 );
+        CHECK( entry.numberOfSamples == 0 );
+        CHECK( entry.seconds == 0.0 );
+    }
+}
+
+} // namespace splinekernel
+} // namespace cie
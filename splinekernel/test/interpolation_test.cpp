@@ -1,6 +1,8 @@
 #include "catch.hpp"
 #include "interpolation.hpp"
+#include "curve.hpp"
 #include <algorithm>
+#include <cmath>
 
 namespace cie
 {
@@ -232,7 +234,120 @@ TEST_CASE("interpolateWithBSplineCurve_test")
     CHECK( is_sorted( knotVector.begin( ), knotVector.end( ) ) );
 }
 
+TEST_CASE( "interpolateManyPoints_test" )
+{
+    size_t n = 2000;
+
+    ControlPoints2D interpolationPoints;
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        double phi = 0.01 * i;
+
+        interpolationPoints[0].push_back( phi * std::cos( phi ) );
+        interpolationPoints[1].push_back( phi * std::sin( phi ) );
+    }
+
+    for( size_t p = 1; p < 6; ++p )
+    {
+        ControlPointsAndKnotVector result;
+
+        REQUIRE_NOTHROW( result = interpolateWithBSplineCurve( interpolationPoints, p ) );
+
+        REQUIRE( result.first[0].size( ) == n );
+        REQUIRE( result.first[1].size( ) == n );
+
+        // The curve must pass through the interpolation points at the parameter positions
+        std::vector<double> t = centripetalParameterPositions( interpolationPoints );
+
+        t.back( ) = 1.0;
+
+        std::array<std::vector<double>, 2> C = evaluate2DCurve( t, result.first[0], result.first[1], result.second );
+
+        for( size_t i = 0; i < n; i += 37 )
+        {
+            CHECK( C[0][i] == Approx( interpolationPoints[0][i] ).margin( 1e-8 ) );
+            CHECK( C[1][i] == Approx( interpolationPoints[1][i] ).margin( 1e-8 ) );
+        }
+    }
+}
+
+TEST_CASE( "interpolateWithBSplineCurveND_test" )
+{
+    size_t n = 50;
+    size_t p = 3;
+
+    // Helix in x, y, z with two attached scalar channels
+    ControlPointsND interpolationPoints( 5 );
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        double phi = 0.2 * i + 0.01 * i * i;
+
+        interpolationPoints[0].push_back( std::cos( phi ) );
+        interpolationPoints[1].push_back( std::sin( phi ) );
+        interpolationPoints[2].push_back( 0.3 * phi );
+        interpolationPoints[3].push_back( 1000.0 * i );
+        interpolationPoints[4].push_back( std::sqrt( 1.0 * i ) );
+    }
 
+    ControlPointsNDAndKnotVector result;
+
+    REQUIRE_NOTHROW( result = interpolateWithBSplineCurveND( interpolationPoints, p, 3 ) );
+
+    REQUIRE( result.first.size( ) == 5 );
+    REQUIRE( result.second.size( ) == n + p + 1 );
+
+    // Only x, y and z determine the parameter positions
+    ControlPointsND geometry( interpolationPoints.begin( ), interpolationPoints.begin( ) + 3 );
+
+    std::vector<double> t = centripetalParameterPositionsND( interpolationPoints, 3 );
+    std::vector<double> expectedT = centripetalParameterPositionsND( geometry );
+
+    REQUIRE( t.size( ) == n );
+
+    for( size_t i = 0; i < n; ++i )
+    {
+        CHECK( t[i] == Approx( expectedT[i] ) );
+    }
+
+    // Each component pair must interpolate its values at the parameter positions
+    t.back( ) = 1.0;
+
+    for( size_t iComponent = 0; iComponent < 5; iComponent += 2 )
+    {
+        size_t jComponent = std::min( iComponent + 1, size_t { 4 } );
+
+        REQUIRE( result.first[iComponent].size( ) == n );
+
+        std::array<std::vector<double>, 2> C = evaluate2DCurve( t, result.first[iComponent],
+                                                                result.first[jComponent], result.second );
+
+        for( size_t i = 0; i < n; ++i )
+        {
+            CHECK( C[0][i] == Approx( interpolationPoints[iComponent][i] ).margin( 1e-8 ) );
+            CHECK( C[1][i] == Approx( interpolationPoints[jComponent][i] ).margin( 1e-8 ) );
+        }
+    }
+
+    // Two components give the same result as the 2D version
+    ControlPointsND points2D{ { 0.0, 15.0, 171.0, 307.0, 907.0 }, { 0.0, 20.0, 85.0, 340.0, 515.0 } };
+
+    ControlPointsAndKnotVector expected = interpolateWithBSplineCurve( { points2D[0], points2D[1] }, p );
+
+    REQUIRE_NOTHROW( result = interpolateWithBSplineCurveND( points2D, p ) );
+
+    for( size_t i = 0; i < points2D[0].size( ); ++i )
+    {
+        CHECK( result.first[0][i] == Approx( expected.first[0][i] ) );
+        CHECK( result.first[1][i] == Approx( expected.first[1][i] ) );
+    }
+
+    // Invalid input
+    CHECK_THROWS( interpolateWithBSplineCurveND( { }, p ) );
+    CHECK_THROWS( interpolateWithBSplineCurveND( { { 0.0, 1.0, 2.0, 3.0 }, { 0.0, 1.0, 2.0 } }, 1 ) );
+    CHECK_THROWS( interpolateWithBSplineCurveND( points2D, p, 3 ) );
+}
 
 } // namespace splinekernel
 } // namespace cie
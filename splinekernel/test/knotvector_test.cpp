@@ -0,0 +1,60 @@
+#include "catch.hpp"
+#include "knotvector.hpp"
+#include "curve.hpp"
+
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+TEST_CASE( "KnotVector_test" )
+{
+    std::vector<double> knots{ 0.0, 0.0, 0.0, 0.0, 1.0, 4.0, 4.0, 9.0, 9.0, 9.0, 9.0 };
+
+    KnotVector knotVector( 7, knots );
+
+    REQUIRE( knotVector.numberOfControlPoints( ) == 7 );
+    REQUIRE( knotVector.polynomialDegree( ) == 3 );
+    REQUIRE( knotVector.knots( ) == knots );
+
+    CHECK( knotVector.breakpoints( ) == std::vector<double>{ 0.0, 1.0, 4.0, 9.0 } );
+    CHECK( knotVector.multiplicities( ) == std::vector<size_t>{ 4, 1, 2, 4 } );
+    CHECK( knotVector.nonzeroKnotSpans( ) == std::vector<size_t>{ 3, 4, 6 } );
+
+    CHECK( knotVector.lowerBound( ) == 0.0 );
+    CHECK( knotVector.upperBound( ) == 9.0 );
+
+    for( double t : { 0.0, 0.5, 1.0, 3.9, 4.0, 8.0, 9.0 } )
+    {
+        CHECK( knotVector.findKnotSpan( t ) == findKnotSpan( t, 7, knots ) );
+    }
+
+    CHECK_THROWS( knotVector.findKnotSpan( 9.5 ) );
+
+    // Copies share the cached data
+    KnotVector copy = knotVector;
+
+    CHECK( &copy.knots( ) == &knotVector.knots( ) );
+}
+
+TEST_CASE( "KnotVector_validation_test" )
+{
+    // Too short for the number of control points
+    CHECK_THROWS( KnotVector( 4, { 0.0, 0.0, 1.0, 1.0, 1.0 } ) );
+
+    // Not sorted
+    CHECK_THROWS( KnotVector( 3, { 0.0, 0.0, 0.6, 0.5, 1.0, 1.0 } ) );
+
+    // No nonzero knot span in [t_p, t_n]
+    CHECK_THROWS( KnotVector( 2, { 0.0, 0.0, 0.0, 0.0, 1.0 } ) );
+
+    // Inner knot repeated more than p + 1 times
+    CHECK_THROWS( KnotVector( 6, { 0.0, 0.0, 0.0, 0.5, 0.5, 0.5, 0.5, 1.0, 1.0 } ) );
+
+    CHECK_NOTHROW( KnotVector( 5, { 0.0, 0.0, 0.0, 0.5, 0.5, 1.0, 1.0, 1.0 } ) );
+}
+
+} // namespace splinekernel
+} // namespace cie
@@ -1,7 +1,10 @@
 #include "catch.hpp"
 #include "surface.hpp"
+#include "basisfunctions.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <vector>
 
 namespace cie
@@ -165,5 +168,309 @@ namespace cie
 
 		} // TEST_CASE("Cubic-linear interpolation surface")
 
+		TEST_CASE("Quadratic-cubic surface with many control points") {
+
+			std::vector<double> knotVectorR{ 0.0, 0.0, 0.0, 0.1, 0.2, 0.25, 0.5, 0.5, 0.7, 0.9, 1.0, 1.0, 1.0 };
+			std::vector<double> knotVectorS{ 0.0, 0.0, 0.0, 0.0, 0.3, 0.4, 0.6, 0.8, 1.0, 1.0, 1.0, 1.0 };
+
+			size_t nR = knotVectorR.size() - 3, nS = knotVectorS.size() - 4;
+			size_t numberOfSamplesR(23), numberOfSamplesS(17);
+
+			linalg::Matrix zGrid(nR, nS, 0.0);
+
+			for (size_t i = 0; i < nR; ++i) {
+				for (size_t j = 0; j < nS; ++j) {
+					zGrid(i, j) = std::sin(1.0 * i) + 0.5 * std::cos(2.0 * j) + 0.1 * i * j;
+				}
+			}
+
+			VectorOfMatrices C;
+			REQUIRE_NOTHROW(C = evaluateSurface({ knotVectorR, knotVectorS }, { zGrid }, { numberOfSamplesR, numberOfSamplesS }));
+
+			REQUIRE(C.size() == 1);
+			REQUIRE(C[0].size1() == numberOfSamplesR);
+			REQUIRE(C[0].size2() == numberOfSamplesS);
+
+			// Compare with the sum over all basis functions times control points
+			for (size_t r = 0; r < numberOfSamplesR; ++r) {
+				for (size_t s = 0; s < numberOfSamplesS; ++s) {
+
+					double tR = r / (numberOfSamplesR - 1.0);
+					double tS = s / (numberOfSamplesS - 1.0);
+					double Z = 0.0;
+
+					for (size_t i = 0; i < nR; ++i) {
+						for (size_t j = 0; j < nS; ++j) {
+							Z += evaluateBSplineBasis(tR, i, 2, knotVectorR) * evaluateBSplineBasis(tS, j, 3, knotVectorS) * zGrid(i, j);
+						}
+					}
+
+					CHECK(C[0](r, s) == Approx(Z));
+				}
+			}
+
+		} // TEST_CASE("Quadratic-cubic surface with many control points")
+
+		TEST_CASE("Surface with a single sample point in one direction") {
+
+			std::vector<double> knotVectorR{ 0.0, 0.0, 0.0, 0.5, 1.0, 1.0, 1.0 };
+			std::vector<double> knotVectorS{ 0.0, 0.0, 0.0, 0.0, 0.4, 1.0, 1.0, 1.0, 1.0 };
+
+			size_t nR = knotVectorR.size() - 3, nS = knotVectorS.size() - 4;
+			size_t numberOfSamplesS(11);
+
+			linalg::Matrix zGrid(nR, nS, 0.0);
+
+			for (size_t i = 0; i < nR; ++i) {
+				for (size_t j = 0; j < nS; ++j) {
+					zGrid(i, j) = 1.0 + 2.0 * i - 0.5 * j + 0.3 * i * j;
+				}
+			}
+
+			// The single sample point is at t = 0
+			for (std::array<size_t, 2> numberOfSamples : { std::array<size_t, 2>{ 1, numberOfSamplesS }, std::array<size_t, 2>{ numberOfSamplesS, 1 } }) {
+
+				VectorOfMatrices C;
+				REQUIRE_NOTHROW(C = evaluateSurface({ knotVectorR, knotVectorS }, { zGrid }, numberOfSamples));
+
+				REQUIRE(C.size() == 1);
+				REQUIRE(C[0].size1() == numberOfSamples[0]);
+				REQUIRE(C[0].size2() == numberOfSamples[1]);
+
+				for (size_t r = 0; r < numberOfSamples[0]; ++r) {
+					for (size_t s = 0; s < numberOfSamples[1]; ++s) {
+
+						double tR = numberOfSamples[0] == 1 ? 0.0 : r / (numberOfSamples[0] - 1.0);
+						double tS = numberOfSamples[1] == 1 ? 0.0 : s / (numberOfSamples[1] - 1.0);
+						double Z = 0.0;
+
+						for (size_t i = 0; i < nR; ++i) {
+							for (size_t j = 0; j < nS; ++j) {
+								Z += evaluateBSplineBasis(tR, i, 2, knotVectorR) * evaluateBSplineBasis(tS, j, 3, knotVectorS) * zGrid(i, j);
+							}
+						}
+
+						CHECK(C[0](r, s) == Approx(Z));
+					}
+				}
+			}
+
+		} // TEST_CASE("Surface with a single sample point in one direction")
+
+		TEST_CASE("Degree six-linear surface") {
+
+			// Degree six has no specialized kernel, degree one has
+			std::vector<double> knotVectorR{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.2, 0.5, 0.5, 0.9, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+			std::vector<double> knotVectorS{ 0.0, 0.0, 0.3, 0.4, 0.6, 0.8, 1.0, 1.0 };
+
+			size_t nR = knotVectorR.size() - 7, nS = knotVectorS.size() - 2;
+			size_t numberOfSamplesR(23), numberOfSamplesS(17);
+
+			linalg::Matrix zGrid(nR, nS, 0.0);
+
+			for (size_t i = 0; i < nR; ++i) {
+				for (size_t j = 0; j < nS; ++j) {
+					zGrid(i, j) = std::sin(1.0 * i) + 0.5 * std::cos(2.0 * j) + 0.1 * i * j;
+				}
+			}
+
+			VectorOfMatrices C;
+			REQUIRE_NOTHROW(C = evaluateSurface({ knotVectorR, knotVectorS }, { zGrid }, { numberOfSamplesR, numberOfSamplesS }));
+
+			REQUIRE(C.size() == 1);
+			REQUIRE(C[0].size1() == numberOfSamplesR);
+			REQUIRE(C[0].size2() == numberOfSamplesS);
+
+			// Compare with the sum over all basis functions times control points
+			for (size_t r = 0; r < numberOfSamplesR; ++r) {
+				for (size_t s = 0; s < numberOfSamplesS; ++s) {
+
+					double tR = r / (numberOfSamplesR - 1.0);
+					double tS = s / (numberOfSamplesS - 1.0);
+					double Z = 0.0;
+
+					for (size_t i = 0; i < nR; ++i) {
+						for (size_t j = 0; j < nS; ++j) {
+							Z += evaluateBSplineBasis(tR, i, 6, knotVectorR) * evaluateBSplineBasis(tS, j, 1, knotVectorS) * zGrid(i, j);
+						}
+					}
+
+					CHECK(C[0](r, s) == Approx(Z));
+				}
+			}
+
+		} // TEST_CASE("Degree six-linear surface")
+
+		TEST_CASE("Surface evaluation at scattered points")
+		{
+			// Cubic in r with 6 elements, quadratic in s with 3 elements and a repeated knot
+			std::vector<double> knotVectorR{ 0.0, 0.0, 0.0, 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 6.0, 6.0, 6.0 };
+			std::vector<double> knotVectorS{ 0.0, 0.0, 0.0, 0.3, 0.3, 1.0, 1.0, 1.0 };
+
+			size_t nR = 9, nS = 5;
+
+			linalg::Matrix xGrid(nR, nS, 0.0), yGrid(nR, nS, 0.0);
+
+			for (size_t i = 0; i < nR; ++i) {
+				for (size_t j = 0; j < nS; ++j) {
+					xGrid(i, j) = std::sin(1.0 + i + 3.0 * j);
+					yGrid(i, j) = std::cos(2.0 * i + j);
+				}
+			}
+
+			// Points in no particular order, including the corners and the repeated knot
+			std::vector<double> r{ 6.0, 0.0, 2.5, 0.0, 6.0, 3.0, 5.9, 0.1 };
+			std::vector<double> s{ 1.0, 0.0, 0.3, 1.0, 0.0, 0.7, 0.29, 0.31 };
+
+			for (size_t i = 0; i < 500; ++i) {
+				r.push_back(6.0 * std::abs(std::sin(12.9898 * i)));
+				s.push_back(std::abs(std::cos(78.233 * i)));
+			}
+
+			std::vector<std::vector<double>> C;
+
+			REQUIRE_NOTHROW(C = evaluateSurfaceAtPoints({ knotVectorR, knotVectorS }, { xGrid, yGrid }, r, s));
+
+			REQUIRE(C.size() == 2);
+			REQUIRE(C[0].size() == r.size());
+			REQUIRE(C[1].size() == r.size());
+
+			// Compare with evaluating a 1 x 1 grid per point
+			for (size_t i = 0; i < r.size(); ++i) {
+				std::array<EvaluationPlan, 2> plans{ EvaluationPlan({ r[i] }, nR, knotVectorR), EvaluationPlan({ s[i] }, nS, knotVectorS) };
+
+				VectorOfMatrices expected = evaluateSurface(plans, { xGrid, yGrid });
+
+				CHECK(C[0][i] == Approx(expected[0](0, 0)));
+				CHECK(C[1][i] == Approx(expected[1](0, 0)));
+			}
+
+			// Many more knot span cells than points are sorted differently
+			std::vector<double> fineKnotVector{ 0.0, 0.0 };
+
+			for (size_t i = 1; i < 1999; ++i) {
+				fineKnotVector.push_back(i / 1999.0);
+			}
+
+			fineKnotVector.push_back(1.0);
+			fineKnotVector.push_back(1.0);
+
+			linalg::Matrix fineGrid(2000, 2000, 0.0);
+
+			for (size_t i = 0; i < 2000; ++i) {
+				fineGrid(i, i) = 1.0;
+			}
+
+			std::vector<double> t{ 0.7, 0.3, 0.30025, 1.0, 0.0 };
+
+			REQUIRE_NOTHROW(C = evaluateSurfaceAtPoints({ fineKnotVector, fineKnotVector }, { fineGrid }, t, t));
+
+			REQUIRE(C.size() == 1);
+
+			for (size_t i = 0; i < t.size(); ++i) {
+				std::array<EvaluationPlan, 2> plans{ EvaluationPlan({ t[i] }, 2000, fineKnotVector), EvaluationPlan({ t[i] }, 2000, fineKnotVector) };
+
+				CHECK(C[0][i] == Approx(evaluateSurface(plans, { fineGrid })[0](0, 0)));
+			}
+
+			CHECK_THROWS(evaluateSurfaceAtPoints({ knotVectorR, knotVectorS }, { xGrid }, { 0.5 }, { 0.5, 0.5 }));
+			CHECK_THROWS(evaluateSurfaceAtPoints({ knotVectorR, knotVectorS }, { xGrid }, { 6.5 }, { 0.5 }));
+			CHECK_THROWS(evaluateSurfaceAtPoints({ knotVectorS, knotVectorR }, { xGrid }, { 0.5 }, { 0.5 }));
+
+			// Outside of [t_p, t_n] of an unclamped knot vector
+			std::vector<double> unclampedKnotVector{ 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0 };
+
+			CHECK_THROWS(evaluateSurfaceAtPoints({ unclampedKnotVector, knotVectorS }, { linalg::Matrix(6, nS, 1.0) }, { 1.0 }, { 0.5 }));
+
+		} // TEST_CASE("Surface evaluation at scattered points")
+
+		TEST_CASE("Surface derivatives and normals")
+		{
+			std::vector<double> knotVectorR{ 0.0, 0.0, 0.0, 0.0, 0.4, 1.0, 1.0, 1.0, 1.0 };
+			std::vector<double> knotVectorS{ 0.0, 0.0, 0.0, 0.5, 1.0, 1.0, 1.0 };
+
+			size_t nR = 5, nS = 4;
+
+			VectorOfMatrices controlPoints(3, linalg::Matrix(nR, nS, 0.0));
+
+			for (size_t i = 0; i < nR; ++i) {
+				for (size_t j = 0; j < nS; ++j) {
+					controlPoints[0](i, j) = i + 0.3 * std::sin(1.0 + j);
+					controlPoints[1](i, j) = j + 0.2 * std::cos(2.0 * i);
+					controlPoints[2](i, j) = std::sin(1.0 + i + 3.0 * j);
+				}
+			}
+
+			size_t numberOfSamplesR = 11, numberOfSamplesS = 7;
+
+			SurfaceDerivatives result;
+
+			REQUIRE_NOTHROW(result = evaluateSurfaceDerivatives({ knotVectorR, knotVectorS }, controlPoints, { numberOfSamplesR, numberOfSamplesS }));
+
+			REQUIRE(result.values.size() == 3);
+			REQUIRE(result.derivativesR.size() == 3);
+			REQUIRE(result.derivativesS.size() == 3);
+			REQUIRE(result.normals.size() == 3);
+
+			VectorOfMatrices expected = evaluateSurface({ knotVectorR, knotVectorS }, controlPoints, { numberOfSamplesR, numberOfSamplesS });
+
+			double h = 1e-6;
+
+			for (size_t iR = 0; iR < numberOfSamplesR; ++iR) {
+				for (size_t iS = 0; iS < numberOfSamplesS; ++iS) {
+					double r = iR / (numberOfSamplesR - 1.0);
+					double s = iS / (numberOfSamplesS - 1.0);
+
+					// One sided finite differences at the boundary of the parameter space
+					double r0 = std::max(r - h, 0.0), r1 = std::min(r + h, 1.0);
+					double s0 = std::max(s - h, 0.0), s1 = std::min(s + h, 1.0);
+
+					std::array<EvaluationPlan, 2> plansR{ EvaluationPlan({ r0, r1 }, nR, knotVectorR), EvaluationPlan({ s }, nS, knotVectorS) };
+					std::array<EvaluationPlan, 2> plansS{ EvaluationPlan({ r }, nR, knotVectorR), EvaluationPlan({ s0, s1 }, nS, knotVectorS) };
+
+					VectorOfMatrices differencesR = evaluateSurface(plansR, controlPoints);
+					VectorOfMatrices differencesS = evaluateSurface(plansS, controlPoints);
+
+					double dot = 0.0, length = 0.0, dotR = 0.0, dotS = 0.0;
+
+					for (size_t i = 0; i < 3; ++i) {
+						CHECK(result.values[i](iR, iS) == Approx(expected[i](iR, iS)));
+						CHECK(result.derivativesR[i](iR, iS) == Approx((differencesR[i](1, 0) - differencesR[i](0, 0)) / (r1 - r0)).epsilon(1e-4));
+						CHECK(result.derivativesS[i](iR, iS) == Approx((differencesS[i](0, 1) - differencesS[i](0, 0)) / (s1 - s0)).epsilon(1e-4));
+
+						length += result.normals[i](iR, iS) * result.normals[i](iR, iS);
+						dotR += result.normals[i](iR, iS) * result.derivativesR[i](iR, iS);
+						dotS += result.normals[i](iR, iS) * result.derivativesS[i](iR, iS);
+					}
+
+					CHECK(length == Approx(1.0));
+					CHECK(dotR == Approx(0.0).margin(1e-10));
+					CHECK(dotS == Approx(0.0).margin(1e-10));
+
+					// Orientation of the normal is dS/dr x dS/ds
+					for (size_t i = 0; i < 3; ++i) {
+						size_t j = (i + 1) % 3, k = (i + 2) % 3;
+
+						dot += result.normals[i](iR, iS) * (result.derivativesR[j](iR, iS) * result.derivativesS[k](iR, iS) -
+						                                    result.derivativesR[k](iR, iS) * result.derivativesS[j](iR, iS));
+					}
+
+					CHECK(dot > 0.0);
+				}
+			}
+
+			// No normals for 2D surfaces
+			REQUIRE_NOTHROW(result = evaluateSurfaceDerivatives({ knotVectorR, knotVectorS }, { controlPoints[0], controlPoints[1] }, { 3, 3 }));
+
+			CHECK(result.derivativesR.size() == 2);
+			CHECK(result.normals.empty());
+
+			// Plans without derivatives
+			std::array<EvaluationPlan, 2> plans{ EvaluationPlan({ 0.5 }, nR, knotVectorR), EvaluationPlan({ 0.5 }, nS, knotVectorS) };
+
+			CHECK_THROWS(evaluateSurfaceDerivatives(plans, controlPoints));
+
+		} // TEST_CASE("Surface derivatives and normals")
+
 	} // namespace splinekernel
 } // namespace cie
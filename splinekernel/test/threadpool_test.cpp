@@ -0,0 +1,178 @@
+#include "catch.hpp"
+#include "threadpool.hpp"
+#include "curve.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+TEST_CASE( "ThreadPool_parallelFor_test" )
+{
+    ThreadPool pool( 4 );
+
+    REQUIRE( pool.numberOfThreads( ) == 4 );
+
+    for( size_t numberOfThreads : { 0, 1, 2, 8 } )
+    {
+        for( size_t grainSize : { 1, 7, 1000 } )
+        {
+            std::vector<std::atomic<int>> visits( 1003 );
+
+            for( auto& visit : visits )
+            {
+                visit = 0;
+            }
+
+            pool.parallelFor( 0, visits.size( ), grainSize, [&]( size_t chunkBegin, size_t chunkEnd )
+            {
+                CHECK( chunkBegin < chunkEnd );
+
+                for( size_t i = chunkBegin; i < chunkEnd; ++i )
+                {
+                    ++visits[i];
+                }
+            }, numberOfThreads );
+
+            // Every index is visited exactly once
+            for( auto& visit : visits )
+            {
+                CHECK( visit == 1 );
+            }
+        }
+    }
+
+    // Empty range
+    REQUIRE_NOTHROW( pool.parallelFor( 5, 5, 1, []( size_t, size_t ) { throw std::runtime_error( "" ); } ) );
+
+    // Exceptions are passed to the calling thread
+    CHECK_THROWS_AS( pool.parallelFor( 0, 100, 1, []( size_t chunkBegin, size_t )
+    {
+        if( chunkBegin > 50 ) throw std::runtime_error( "error" );
+    } ), std::runtime_error );
+
+    // Nested loops do not deadlock
+    std::atomic<size_t> sum( 0 );
+
+    pool.parallelFor( 0, 8, 1, [&]( size_t chunkBegin, size_t chunkEnd )
+    {
+        for( size_t i = chunkBegin; i < chunkEnd; ++i )
+        {
+            pool.parallelFor( 0, 100, 1, [&]( size_t innerBegin, size_t innerEnd )
+            {
+                sum += innerEnd - innerBegin;
+            } );
+        }
+    } );
+
+    CHECK( sum == 800 );
+
+    // Tasks run on worker threads
+    std::promise<int> promise;
+
+    pool.enqueue( [&]( ) { promise.set_value( 42 ); } );
+
+    CHECK( promise.get_future( ).get( ) == 42 );
+}
+
+TEST_CASE( "ParallelCurveEvaluation_test" )
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 1.0, 4.0, 9.0, 9.0, 9.0, 9.0 };
+    std::vector<double> x{ 0.0, 10.0, 9.0, 4.5, 1.5, 1.0 };
+    std::vector<double> y{ 0.0,  1.0, 4.0, 7.5, 6.0, 1.0 };
+
+    std::vector<double> t( 20000 );
+
+    for( size_t i = 0; i < t.size( ); ++i )
+    {
+        t[i] = 9.0 * i / ( t.size( ) - 1.0 );
+    }
+
+    size_t numberOfThreads = getNumberOfThreads( );
+
+    setNumberOfThreads( 1 );
+
+    REQUIRE( getNumberOfThreads( ) == 1 );
+
+    std::array<std::vector<double>, 2> expected = evaluate2DCurve( t, x, y, knotVector );
+
+    setNumberOfThreads( 4 );
+
+    std::array<std::vector<double>, 2> C1 = evaluate2DCurve( t, x, y, knotVector );
+    std::array<std::vector<double>, 2> C2 = evaluate2DCurveDeBoor( t, x, y, knotVector );
+
+    // Results do not depend on the number of threads
+    for( size_t i = 0; i < t.size( ); ++i )
+    {
+        REQUIRE( C1[0][i] == expected[0][i] );
+        REQUIRE( C1[1][i] == expected[1][i] );
+        REQUIRE( C2[0][i] == Approx( expected[0][i] ) );
+        REQUIRE( C2[1][i] == Approx( expected[1][i] ) );
+    }
+
+    t[15000] = 10.0;
+
+    CHECK_THROWS( evaluate2DCurve( t, x, y, knotVector ) );
+
+    setNumberOfThreads( numberOfThreads );
+}
+
+TEST_CASE( "RunAsync_test" )
+{
+    size_t numberOfThreads = getNumberOfThreads( );
+
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 1.0, 4.0, 9.0, 9.0, 9.0, 9.0 };
+    std::vector<double> x{ 0.0, 10.0, 9.0, 4.5, 1.5, 1.0 };
+    std::vector<double> y{ 0.0,  1.0, 4.0, 7.5, 6.0, 1.0 };
+
+    std::vector<double> t( 5000 );
+
+    for( size_t i = 0; i < t.size( ); ++i )
+    {
+        t[i] = 9.0 * i / ( t.size( ) - 1.0 );
+    }
+
+    std::array<std::vector<double>, 2> expected = evaluate2DCurve( t, x, y, knotVector );
+
+    // Also with a single evaluation thread the tasks need to run on a worker
+    for( size_t n : { size_t { 1 }, size_t { 3 } } )
+    {
+        setNumberOfThreads( n );
+
+        std::vector<std::future<std::array<std::vector<double>, 2>>> futures;
+
+        for( size_t i = 0; i < 4; ++i )
+        {
+            futures.push_back( runAsync( [&]( ) { return evaluate2DCurve( t, x, y, knotVector ); } ) );
+        }
+
+        for( auto& future : futures )
+        {
+            std::array<std::vector<double>, 2> C = future.get( );
+
+            REQUIRE( C[0].size( ) == t.size( ) );
+
+            for( size_t i = 0; i < t.size( ); ++i )
+            {
+                REQUIRE( C[0][i] == expected[0][i] );
+                REQUIRE( C[1][i] == expected[1][i] );
+            }
+        }
+
+        // Exceptions are passed on to the caller of get
+        auto failing = runAsync( [&]( ) { return evaluate2DCurve( { 10.0 }, x, y, knotVector ); } );
+
+        CHECK_THROWS_AS( failing.get( ), std::out_of_range );
+    }
+
+    setNumberOfThreads( numberOfThreads );
+}
+
+} // namespace splinekernel
+} // namespace cie
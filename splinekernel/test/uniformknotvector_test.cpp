@@ -0,0 +1,149 @@
+#include "catch.hpp"
+#include "uniformknotvector.hpp"
+#include "basisfunctions.hpp"
+#include "curve.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace cie
+{
+namespace splinekernel
+{
+
+TEST_CASE( "UniformBasisMatrix_test" )
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 0.0, 0.5, 1.0, 1.5, 2.0, 2.5, 3.0, 3.0, 3.0, 3.0 };
+
+    UniformKnotVector uniform( 9, knotVector );
+
+    REQUIRE( uniform.isUniform( ) );
+    REQUIRE( uniform.polynomialDegree( ) == 3 );
+    CHECK( uniform.knotDistance( ) == Approx( 0.5 ) );
+
+    // Segments of the uniform cubic B-spline
+    std::vector<double> expected{ 1.0 / 6.0, -0.5,  0.5, -1.0 / 6.0,
+                                  2.0 / 3.0,  0.0, -1.0,  0.5,
+                                  1.0 / 6.0,  0.5,  0.5, -0.5,
+                                  0.0,        0.0,  0.0,  1.0 / 6.0 };
+
+    REQUIRE( uniform.basisMatrix( ).size( ) == expected.size( ) );
+
+    for( size_t i = 0; i < expected.size( ); ++i )
+    {
+        CHECK( uniform.basisMatrix( )[i] == Approx( expected[i] ).margin( 1e-14 ) );
+    }
+
+    // Only the spans [1.0, 1.5] and [1.5, 2.0] are not influenced by the repeated end knots
+    for( size_t span = 3; span < 9; ++span )
+    {
+        CHECK( uniform.hasUniformBasis( span ) == ( span == 5 || span == 6 ) );
+    }
+}
+
+TEST_CASE( "UniformKnotSpan_test" )
+{
+    std::vector<double> knotVector{ 1.0, 1.0, 1.0, 1.3, 1.6, 1.9, 2.2, 2.5, 2.8, 3.1, 3.1, 3.1 };
+
+    size_t n = 9;
+
+    UniformKnotVector uniform( n, knotVector );
+
+    REQUIRE( uniform.isUniform( ) );
+
+    for( size_t i = 0; i <= 2100; ++i )
+    {
+        double t = 1.0 + i * 0.001;
+
+        REQUIRE( uniform.findKnotSpan( t ) == findKnotSpan( t, n, knotVector ) );
+    }
+
+    for( double t : knotVector )
+    {
+        CHECK( uniform.findKnotSpan( t ) == findKnotSpan( t, n, knotVector ) );
+    }
+
+    CHECK_THROWS( uniform.findKnotSpan( 0.9 ) );
+    CHECK_THROWS( uniform.findKnotSpan( 3.2 ) );
+    CHECK_THROWS( uniform.findKnotSpan( std::numeric_limits<double>::quiet_NaN( ) ) );
+}
+
+TEST_CASE( "UniformBasisFunctions_test" )
+{
+    for( size_t p = 1; p < 7; ++p )
+    {
+        // Clamped and unclamped uniform knot vectors
+        for( bool clamped : { true, false } )
+        {
+            size_t n = 2 * p + 6;
+
+            std::vector<double> knotVector;
+
+            for( size_t i = 0; i < n + p + 1; ++i )
+            {
+                double k = clamped ? std::min( std::max( i, p ), n ) - p : i;
+
+                knotVector.push_back( -2.0 + 0.25 * k );
+            }
+
+            UniformKnotVector uniform( n, knotVector );
+
+            REQUIRE( uniform.isUniform( ) );
+
+            std::vector<double> N1( p + 1 ), N2( p + 1 );
+
+            for( size_t i = 0; i <= 100; ++i )
+            {
+                double t = knotVector[p] + i / 100.0 * ( knotVector[n] - knotVector[p] );
+
+                size_t span = uniform.findKnotSpan( t );
+
+                REQUIRE( span == findKnotSpan( t, n, knotVector ) );
+
+                CHECK( uniform.hasUniformBasis( span ) == ( !clamped || ( span >= 2 * p - 1 && span + p <= n ) ) );
+
+                uniform.evaluateNonzeroBasis( t, span, N1.data( ) );
+                evaluateNonzeroBSplineBasis( t, span, p, knotVector, N2.data( ) );
+
+                for( size_t j = 0; j <= p; ++j )
+                {
+                    CHECK( N1[j] == Approx( N2[j] ).margin( 1e-13 ) );
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE( "NonuniformKnotVector_test" )
+{
+    std::vector<double> knotVector{ 0.0, 0.0, 0.0, 1.0, 2.0, 3.1, 4.0, 4.0, 4.0 };
+
+    UniformKnotVector uniform( 6, knotVector );
+
+    CHECK_FALSE( uniform.isUniform( ) );
+
+    for( size_t span = 2; span < 6; ++span )
+    {
+        CHECK_FALSE( uniform.hasUniformBasis( span ) );
+    }
+
+    // Falls back to the general algorithms
+    CHECK( uniform.findKnotSpan( 3.5 ) == 5 );
+    CHECK( uniform.findKnotSpan( 4.0 ) == 5 );
+
+    std::vector<double> N1( 3 ), N2( 3 );
+
+    uniform.evaluateNonzeroBasis( 2.5, 4, N1.data( ) );
+    evaluateNonzeroBSplineBasis( 2.5, 4, 2, knotVector, N2.data( ) );
+
+    for( size_t j = 0; j < 3; ++j )
+    {
+        CHECK( N1[j] == N2[j] );
+    }
+
+    CHECK_THROWS( UniformKnotVector( 9, knotVector ) );
+}
+
+} // namespace splinekernel
+} // namespace cie